@@ -0,0 +1,33 @@
+/**
+ * @file Adafruit_NeoPixel.h
+ * @brief WS2812 strip mock for host build
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#define NEO_GRB ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel
+{
+public:
+  Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type);
+  void begin();
+  void show();
+  void clear();
+  void fill(uint32_t color = 0, uint16_t first = 0, uint16_t count = 0);
+  void setPixelColor(uint16_t index, uint32_t color);
+  void setPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+  uint32_t getPixelColor(uint16_t index) const;
+  uint16_t numPixels() const;
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b);
+
+private:
+  std::vector<uint32_t> m_pixels;
+};
@@ -0,0 +1,102 @@
+/**
+ * @file Arduino.h
+ * @brief Arduino core mock for host build
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define F(string_literal) (string_literal)
+#define pgm_read_byte(address) (*reinterpret_cast<const uint8_t*>(address))
+#define pgm_read_word(address) (*reinterpret_cast<const uint16_t*>(address))
+#define pgm_read_dword(address) (*reinterpret_cast<const uint32_t*>(address))
+#define memcpy_P memcpy
+#define PSTR(string_literal) (string_literal)
+#define strncmp_P strncmp
+#define strlen_P strlen
+
+#define DEC 10
+#define HEX 16
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define SERIAL_TX_BUFFER_SIZE 64
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+#define digitalPinToInterrupt(pin) ((pin) == 2 ? 0 : ((pin) == 3 ? 1 : -1))
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts();
+void interrupts();
+
+///< base of Serial and other text outputs, numbers are formatted and sent by write()
+class Print
+{
+public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t value) = 0;
+  size_t write(const char* text);
+  size_t print(const char* text);
+  size_t print(char value);
+  size_t print(unsigned char value, int base = DEC);
+  size_t print(int value, int base = DEC);
+  size_t print(unsigned int value, int base = DEC);
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(double value, int digits = 2);
+  size_t println();
+
+  template<typename T>
+  size_t println(T value)
+  {
+    size_t size = print(value);
+    return size + println();
+  }
+
+  template<typename T>
+  size_t println(T value, int format)
+  {
+    size_t size = print(value, format);
+    return size + println();
+  }
+
+private:
+  size_t print_number(unsigned long value, bool is_negative, int base);
+};
+
+///< Serial mock, TX buffer is drained at baudrate on simulated clock, output goes to stdout when echo is enabled in Hal_native
+class HardwareSerial : public Print
+{
+public:
+  using Print::write;
+
+  void begin(unsigned long baudrate);
+  int available();
+  int read();
+  int availableForWrite();
+  size_t write(uint8_t value) override;
+};
+
+extern HardwareSerial Serial;
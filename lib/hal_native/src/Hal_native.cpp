@@ -0,0 +1,569 @@
+/**
+ * @file Hal_native.cpp
+ * @brief Mock drivers for host build
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Hal_native.h"
+
+#include "Adafruit_NeoPixel.h"
+#include "Arduino.h"
+#include "RTClib.h"
+#include "Servo.h"
+
+#include <deque>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace
+{
+uint64_t m_micros = 0; ///< simulated time from start
+uint32_t m_rtc_base = 946684800; ///< RTC unix time at m_rtc_base_micros
+uint64_t m_rtc_base_micros = 0; ///< simulated time of last RTC adjust
+bool m_serial_echo = true; ///< print Serial output on stdout
+void (*m_serial_handler)(char) = nullptr; ///< receives Serial output, e.g. for checks of log
+unsigned long m_serial_baudrate = 9600; ///< UART speed
+uint16_t m_serial_tx_pending = 0; ///< bytes in TX buffer
+uint64_t m_serial_tx_micros = 0; ///< simulated time of last TX buffer drain
+std::deque<char> m_serial_rx; ///< bytes for Serial.read()
+uint8_t m_analog[Hal_native::pin_count] = {}; ///< last analogWrite values
+int m_servo_angle = 90; ///< last servo angle
+Hal_native::Counters m_counters = {}; ///< driver usage
+bool m_is_sqw_enabled = false; ///< DS1307 1 Hz output is on
+void (*m_interrupts[2])() = {}; ///< INT0 and INT1 handlers
+int m_interrupt_modes[2] = {}; ///< CHANGE, FALLING or RISING of handlers
+uint8_t m_nvram[56] = {}; ///< DS1307 RAM, kept between setup() calls like battery backed RAM
+std::vector<uint32_t> m_ws2812_received; ///< pixels sent since last latch
+std::vector<uint32_t> m_ws2812_shown; ///< pixels shown by last latch
+
+const uint32_t m_sec_in_day = 86400;
+
+/**
+ * @brief days from 1970-01-01, proleptic Gregorian calendar
+ */
+int32_t days_from_civil(int32_t year, uint8_t month, uint8_t day)
+{
+  year -= month <= 2;
+  int32_t era = (year >= 0 ? year : year - 399) / 400;
+  uint32_t yoe = static_cast<uint32_t>(year - era * 400);
+  uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + static_cast<int32_t>(doe) - 719468;
+}
+
+/**
+ * @brief remove bytes sent by UART since last call from simulated TX buffer
+ */
+void drain_serial_tx()
+{
+  uint64_t sent = (m_micros - m_serial_tx_micros) * m_serial_baudrate / 10 / 1000000;
+  if (sent == 0)
+  {
+    return;
+  }
+  m_serial_tx_pending = (sent >= m_serial_tx_pending) ? 0 : m_serial_tx_pending - sent;
+  m_serial_tx_micros = m_micros;
+}
+/**
+ * @brief get DS1307 SQW level, 1 Hz square wave falls when seconds change and rises in half of second
+ */
+int get_sqw_level()
+{
+  return (m_is_sqw_enabled && (m_micros - m_rtc_base_micros) % 1000000 < 500000) ? LOW : HIGH;
+}
+
+/**
+ * @brief move clock, call SQW handler on each edge which matches its mode
+ */
+void advance_clock(uint64_t us)
+{
+  uint64_t end = m_micros + us;
+  int interrupt = digitalPinToInterrupt(Hal_native::rtc_sqw_pin);
+  if (m_is_sqw_enabled && interrupt >= 0 && m_interrupts[interrupt])
+  {
+    uint64_t next_edge = m_micros + 500000 - (m_micros - m_rtc_base_micros) % 500000;
+    while (next_edge <= end)
+    {
+      m_micros = next_edge;
+      int mode = m_interrupt_modes[interrupt];
+      bool is_falling = get_sqw_level() == LOW;
+      if (mode == CHANGE || (mode == FALLING) == is_falling)
+      {
+        m_interrupts[interrupt]();
+      }
+      next_edge += 500000;
+    }
+  }
+  m_micros = end;
+}
+} // namespace
+
+HardwareSerial Serial;
+
+void Hal_native::set_time(const DateTime& time)
+{
+  m_rtc_base = time.unixtime();
+  m_rtc_base_micros = m_micros;
+}
+
+void Hal_native::advance_us(uint64_t us)
+{
+  advance_clock(us);
+}
+
+uint64_t Hal_native::get_time_us()
+{
+  return m_micros;
+}
+
+void Hal_native::set_serial_echo(bool is_enabled)
+{
+  m_serial_echo = is_enabled;
+}
+
+void Hal_native::set_serial_handler(void (*handler)(char value))
+{
+  m_serial_handler = handler;
+}
+
+void Hal_native::feed_serial(const char* text)
+{
+  while (*text)
+  {
+    m_serial_rx.push_back(*text++);
+  }
+}
+
+uint8_t Hal_native::get_analog_value(uint8_t pin)
+{
+  return (pin < pin_count) ? m_analog[pin] : 0;
+}
+
+int Hal_native::get_servo_angle()
+{
+  return m_servo_angle;
+}
+
+void Hal_native::send_ws2812_pixel(uint8_t r, uint8_t g, uint8_t b)
+{
+  m_ws2812_received.push_back(Adafruit_NeoPixel::Color(r, g, b));
+}
+
+void Hal_native::latch_ws2812()
+{
+  m_ws2812_shown.swap(m_ws2812_received);
+  m_ws2812_received.clear();
+  m_counters.strip_shows++;
+}
+
+uint32_t Hal_native::get_ws2812_pixel(uint16_t index)
+{
+  return (index < m_ws2812_shown.size()) ? m_ws2812_shown[index] : 0;
+}
+
+const Hal_native::Counters& Hal_native::get_counters()
+{
+  return m_counters;
+}
+
+void Hal_native::reset_counters()
+{
+  m_counters = Counters();
+}
+
+unsigned long millis()
+{
+  return static_cast<unsigned long>(m_micros / 1000);
+}
+
+unsigned long micros()
+{
+  return static_cast<unsigned long>(m_micros);
+}
+
+void delay(unsigned long ms)
+{
+  advance_clock(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  advance_clock(us);
+}
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t, uint8_t) {}
+
+int digitalRead(uint8_t pin)
+{
+  return (pin == Hal_native::rtc_sqw_pin) ? get_sqw_level() : HIGH;
+}
+
+void analogWrite(uint8_t pin, int value)
+{
+  m_counters.analog_writes++;
+  if (pin < Hal_native::pin_count)
+  {
+    m_analog[pin] = static_cast<uint8_t>(value);
+  }
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode)
+{
+  if (interrupt < 2)
+  {
+    m_interrupts[interrupt] = handler;
+    m_interrupt_modes[interrupt] = mode;
+  }
+}
+
+void detachInterrupt(uint8_t interrupt)
+{
+  if (interrupt < 2)
+  {
+    m_interrupts[interrupt] = nullptr;
+  }
+}
+
+void noInterrupts() {}
+
+void interrupts() {}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+size_t Print::write(const char* text)
+{
+  size_t size = 0;
+  while (*text)
+  {
+    size += write(static_cast<uint8_t>(*text++));
+  }
+  return size;
+}
+
+size_t Print::print(const char* text)
+{
+  return write(text);
+}
+
+size_t Print::print(char value)
+{
+  return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+  return print_number(value, false, base);
+}
+
+size_t Print::print(int value, int base)
+{
+  return print(static_cast<long>(value), base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+  return print_number(value, false, base);
+}
+
+size_t Print::print(long value, int base)
+{
+  if (value < 0 && base == DEC)
+  {
+    return print_number(static_cast<unsigned long>(-value), true, base);
+  }
+  return print_number(static_cast<unsigned long>(value), false, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+  return print_number(value, false, base);
+}
+
+size_t Print::print(double value, int digits)
+{
+  char text[32];
+  snprintf(text, sizeof(text), "%.*f", digits, value);
+  return write(text);
+}
+
+size_t Print::println()
+{
+  return write("\r\n");
+}
+
+size_t Print::print_number(unsigned long value, bool is_negative, int base)
+{
+  char buffer[34];
+  char* digit = &buffer[sizeof(buffer) - 1];
+  *digit = '\0';
+  if (base < 2)
+  {
+    base = DEC;
+  }
+  do
+  {
+    uint8_t rest = value % base;
+    *--digit = rest < 10 ? '0' + rest : 'A' + rest - 10;
+    value /= base;
+  } while (value);
+  if (is_negative)
+  {
+    *--digit = '-';
+  }
+  return write(digit);
+}
+
+void HardwareSerial::begin(unsigned long baudrate)
+{
+  m_serial_baudrate = baudrate;
+  m_serial_tx_pending = 0;
+  m_serial_tx_micros = m_micros;
+}
+
+int HardwareSerial::available()
+{
+  return static_cast<int>(m_serial_rx.size());
+}
+
+int HardwareSerial::read()
+{
+  if (m_serial_rx.empty())
+  {
+    return -1;
+  }
+  char value = m_serial_rx.front();
+  m_serial_rx.pop_front();
+  return static_cast<uint8_t>(value);
+}
+
+int HardwareSerial::availableForWrite()
+{
+  drain_serial_tx();
+  return SERIAL_TX_BUFFER_SIZE - 1 - m_serial_tx_pending;
+}
+
+size_t HardwareSerial::write(uint8_t value)
+{
+  if (availableForWrite() <= 0)
+  {
+    // like HardwareSerial on AVR, wait for UART to send one byte
+    m_counters.serial_stalls++;
+    m_serial_tx_micros = m_micros;
+    advance_clock((10000000ULL + m_serial_baudrate - 1) / m_serial_baudrate);
+    drain_serial_tx();
+  }
+  m_serial_tx_pending++;
+  m_counters.serial_bytes++;
+  if (m_serial_echo)
+  {
+    putchar(value);
+  }
+  if (m_serial_handler)
+  {
+    m_serial_handler(static_cast<char>(value));
+  }
+  return 1;
+}
+
+uint8_t Servo::attach(int)
+{
+  m_counters.servo_attaches++;
+  m_attached = true;
+  return 0;
+}
+
+void Servo::detach()
+{
+  m_attached = false;
+}
+
+void Servo::write(int value)
+{
+  if (value < 0)
+  {
+    value = 0;
+  }
+  else if (value > 180)
+  {
+    value = 180;
+  }
+  writeMicroseconds(map(value, 0, 180, 544, 2400));
+  m_servo_angle = value;
+}
+
+void Servo::writeMicroseconds(int value)
+{
+  m_counters.servo_writes++;
+  m_pulse_us = value;
+  m_servo_angle = static_cast<int>(map(value, 544, 2400, 0, 180));
+}
+
+int Servo::read()
+{
+  return static_cast<int>(map(m_pulse_us + 1, 544, 2400, 0, 180));
+}
+
+int Servo::readMicroseconds()
+{
+  return m_pulse_us;
+}
+
+bool Servo::attached()
+{
+  return m_attached;
+}
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t count, int16_t, uint16_t)
+: m_pixels(count, 0)
+{}
+
+void Adafruit_NeoPixel::begin() {}
+
+void Adafruit_NeoPixel::show()
+{
+  m_counters.strip_shows++;
+}
+
+void Adafruit_NeoPixel::clear()
+{
+  fill(0);
+}
+
+void Adafruit_NeoPixel::fill(uint32_t color, uint16_t first, uint16_t count)
+{
+  uint16_t end = (count == 0 || first + count > numPixels()) ? numPixels() : first + count;
+  for (uint16_t i = first; i < end; i++)
+  {
+    m_pixels[i] = color;
+  }
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint32_t color)
+{
+  if (index < numPixels())
+  {
+    m_pixels[index] = color;
+  }
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t index, uint8_t r, uint8_t g, uint8_t b)
+{
+  setPixelColor(index, Color(r, g, b));
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t index) const
+{
+  return (index < numPixels()) ? m_pixels[index] : 0;
+}
+
+uint16_t Adafruit_NeoPixel::numPixels() const
+{
+  return static_cast<uint16_t>(m_pixels.size());
+}
+
+uint32_t Adafruit_NeoPixel::Color(uint8_t r, uint8_t g, uint8_t b)
+{
+  return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+}
+
+DateTime::DateTime(uint32_t unix_time)
+{
+  int32_t days = static_cast<int32_t>(unix_time / m_sec_in_day);
+  uint32_t seconds = unix_time % m_sec_in_day;
+  m_hour = seconds / 3600;
+  m_minute = (seconds / 60) % 60;
+  m_second = seconds % 60;
+
+  days += 719468;
+  int32_t era = days / 146097;
+  uint32_t doe = static_cast<uint32_t>(days - era * 146097);
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  m_day = doy - (153 * mp + 2) / 5 + 1;
+  m_month = mp < 10 ? mp + 3 : mp - 9;
+  m_year = static_cast<uint16_t>(yoe + era * 400 + (m_month <= 2));
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t min, uint8_t sec)
+: m_year(year < 100 ? year + 2000 : year)
+, m_month(month)
+, m_day(day)
+, m_hour(hour)
+, m_minute(min)
+, m_second(sec)
+{}
+
+DateTime::DateTime(const char* date, const char* time)
+{
+  const char* months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  m_month = 1;
+  for (uint8_t i = 0; i < 12; i++)
+  {
+    if (strncmp(date, &months[i * 3], 3) == 0)
+    {
+      m_month = i + 1;
+    }
+  }
+  m_day = static_cast<uint8_t>(atoi(date + 4));
+  m_year = static_cast<uint16_t>(atoi(date + 7));
+  m_hour = static_cast<uint8_t>(atoi(time));
+  m_minute = static_cast<uint8_t>(atoi(time + 3));
+  m_second = static_cast<uint8_t>(atoi(time + 6));
+}
+
+uint32_t DateTime::unixtime() const
+{
+  return static_cast<uint32_t>(days_from_civil(m_year, m_month, m_day)) * m_sec_in_day + m_hour * 3600UL + m_minute * 60UL + m_second;
+}
+
+bool RTC_DS1307::begin()
+{
+  return true;
+}
+
+bool RTC_DS1307::isrunning()
+{
+  return true;
+}
+
+void RTC_DS1307::adjust(const DateTime& time)
+{
+  Hal_native::set_time(time);
+}
+
+DateTime RTC_DS1307::now()
+{
+  m_counters.rtc_reads++;
+  return DateTime(static_cast<uint32_t>(m_rtc_base + (m_micros - m_rtc_base_micros) / 1000000));
+}
+
+void RTC_DS1307::writeSqwPinMode(Ds1307SqwPinMode mode)
+{
+  m_is_sqw_enabled = (mode == DS1307_SquareWave1HZ);
+}
+
+void RTC_DS1307::readnvram(uint8_t* buf, uint8_t size, uint8_t address)
+{
+  for (uint8_t i = 0; i < size; i++)
+  {
+    buf[i] = (address + i < sizeof(m_nvram)) ? m_nvram[address + i] : 0;
+  }
+}
+
+void RTC_DS1307::writenvram(uint8_t address, const uint8_t* buf, uint8_t size)
+{
+  m_counters.nvram_writes++;
+  for (uint8_t i = 0; i < size && address + i < sizeof(m_nvram); i++)
+  {
+    m_nvram[address + i] = buf[i];
+  }
+}
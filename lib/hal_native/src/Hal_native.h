@@ -0,0 +1,112 @@
+/**
+ * @file Hal_native.h
+ * @brief Control and inspection of mock drivers for host build
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "RTClib.h"
+
+#include <stdint.h>
+
+namespace Hal_native
+{
+const uint8_t pin_count = 20; ///< Arduino Nano digital and analog pins
+const uint8_t rtc_sqw_pin = 2; ///< DS1307 SQW/OUT is wired to this pin
+
+///< how many times each driver was used
+struct Counters
+{
+  uint32_t analog_writes;
+  uint32_t servo_attaches;
+  uint32_t servo_writes;
+  uint32_t strip_shows;
+  uint32_t serial_bytes;
+  uint32_t serial_stalls; ///< writes blocked by full TX buffer
+  uint32_t rtc_reads; ///< I2C reads of time
+  uint32_t nvram_writes; ///< writes to RTC RAM
+};
+
+/**
+ * @brief set simulated RTC time, millis() keeps counting
+ * @param time: new RTC time
+ */
+void set_time(const DateTime& time);
+
+/**
+ * @brief move simulated clock forward, also used by delay(), SQW interrupts are called on the way on falling and rising edges
+ * @param us: time in microseconds
+ */
+void advance_us(uint64_t us);
+
+/**
+ * @brief get simulated time without 32 bit overflow of micros()
+ * @return uint64_t time in microseconds from start
+ */
+uint64_t get_time_us();
+
+/**
+ * @brief enable printing Serial output on stdout
+ * @param is_enabled: true = print; false = discard
+ */
+void set_serial_echo(bool is_enabled);
+
+/**
+ * @brief call function for every byte written to Serial, independent of echo
+ * @param handler: function called with byte, nullptr = none
+ */
+void set_serial_handler(void (*handler)(char value));
+
+/**
+ * @brief queue bytes to be read by Serial.read()
+ * @param text: bytes to receive
+ */
+void feed_serial(const char* text);
+
+/**
+ * @brief get last value written by analogWrite
+ * @param pin: pin number
+ * @return uint8_t PWM value
+ */
+uint8_t get_analog_value(uint8_t pin);
+
+/**
+ * @brief get last servo angle
+ * @return int angle 0-180
+ */
+int get_servo_angle();
+
+/**
+ * @brief receive one pixel on WS2812 line without framebuffer (Sky_stream), pixels after latch start from first one
+ * @param r: red
+ * @param g: green
+ * @param b: blue
+ */
+void send_ws2812_pixel(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief end of WS2812 transmission, received pixels are shown
+ */
+void latch_ws2812();
+
+/**
+ * @brief get pixel shown by last latch_ws2812()
+ * @param index: pixel number
+ * @return uint32_t color 0x00RRGGBB, 0 after end of strip
+ */
+uint32_t get_ws2812_pixel(uint16_t index);
+
+/**
+ * @brief get counters
+ * @return const Counters& driver usage
+ */
+const Counters& get_counters();
+
+/**
+ * @brief reset counters to zero
+ */
+void reset_counters();
+} // namespace Hal_native
@@ -0,0 +1,75 @@
+/**
+ * @file RTClib.h
+ * @brief DS1307 RTC mock for host build, time comes from simulated clock in Hal_native
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class DateTime
+{
+public:
+  DateTime(uint32_t unix_time = 946684800);
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+  DateTime(const char* date, const char* time);
+  uint16_t year() const
+  {
+    return m_year;
+  }
+  uint8_t month() const
+  {
+    return m_month;
+  }
+  uint8_t day() const
+  {
+    return m_day;
+  }
+  uint8_t hour() const
+  {
+    return m_hour;
+  }
+  uint8_t minute() const
+  {
+    return m_minute;
+  }
+  uint8_t second() const
+  {
+    return m_second;
+  }
+  uint32_t unixtime() const;
+
+private:
+  uint16_t m_year;
+  uint8_t m_month;
+  uint8_t m_day;
+  uint8_t m_hour;
+  uint8_t m_minute;
+  uint8_t m_second;
+};
+
+///< DS1307 SQW/OUT pin modes, only 1 Hz is simulated
+enum Ds1307SqwPinMode
+{
+  DS1307_OFF = 0x00,
+  DS1307_ON = 0x80,
+  DS1307_SquareWave1HZ = 0x10,
+  DS1307_SquareWave4kHz = 0x11,
+  DS1307_SquareWave8kHz = 0x12,
+  DS1307_SquareWave32kHz = 0x13
+};
+
+class RTC_DS1307
+{
+public:
+  bool begin();
+  bool isrunning();
+  void adjust(const DateTime& time);
+  DateTime now();
+  void writeSqwPinMode(Ds1307SqwPinMode mode);
+  void readnvram(uint8_t* buf, uint8_t size, uint8_t address);
+  void writenvram(uint8_t address, const uint8_t* buf, uint8_t size);
+};
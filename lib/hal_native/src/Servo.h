@@ -0,0 +1,27 @@
+/**
+ * @file Servo.h
+ * @brief Servo mock for host build
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class Servo
+{
+public:
+  uint8_t attach(int pin);
+  void detach();
+  void write(int value);
+  void writeMicroseconds(int value);
+  int read();
+  int readMicroseconds();
+  bool attached();
+
+private:
+  bool m_attached = false;
+  int m_pulse_us = 1500;
+};
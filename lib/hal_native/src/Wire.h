@@ -0,0 +1,9 @@
+/**
+ * @file Wire.h
+ * @brief I2C mock for host build, RTC mock does not use bus
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
@@ -0,0 +1,166 @@
+"""
+@file ram_report.py
+@brief static RAM used by each module and flash tables, printed after linking
+@author by Szymon Markiewicz
+@details http://www.inzynierdomu.pl/
+@date 10-2026
+
+PlatformIO extra script, reads linker map of firmware and sums .data, .bss and
+.noinit input sections per object file. Heap (NeoPixel buffer, 3 bytes per LED)
+and stack are not static, they use RAM left after this report.
+
+Then every variable declared with PROGMEM in src is looked up with avr-nm in
+firmware and its size and address are printed. Variable in RAM (address from
+0x800000, e.g. template static member which lost attribute) fails the build.
+"""
+
+import os
+import re
+import subprocess
+
+Import("env")  # noqa: F821 - defined by PlatformIO
+
+RAM_SIZE = 2048  # ATmega328P
+RAM_SECTIONS = (".data", ".bss", ".noinit")
+TOP_SYMBOLS = 12
+RAM_ADDRESS = 0x800000  # avr-gcc data address space, flash is below
+
+MAP_PATH = os.path.join(env.subst("$BUILD_DIR"), "firmware.map")  # noqa: F821
+env.Append(LINKFLAGS=["-Wl,-Map," + MAP_PATH])  # noqa: F821
+
+INPUT_LINE = re.compile(r"^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+PROGMEM_DECLARATION = re.compile(r"(\w+)\s*(?:\[[^\]]*\])?\s+PROGMEM\b")
+NM_LINE = re.compile(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+\w\s+(.+)$")
+
+
+def get_module(path):
+    """object file name without directories and extensions, archive member for libraries"""
+    member = re.search(r"\(([^)]+)\)$", path)
+    name = os.path.basename(member.group(1) if member else path)
+    for suffix in (".o", ".cpp", ".c", ".S"):
+        if name.endswith(suffix):
+            name = name[: -len(suffix)]
+    return name
+
+
+def read_ram_sections(map_path):
+    """list of (input section, size, module) placed in RAM output sections"""
+    sections = []
+    output_section = None
+    pending_name = None
+    is_memory_map = False
+    with open(map_path, encoding="utf-8", errors="replace") as map_file:
+        for line in map_file:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                is_memory_map = True
+                continue
+            if not is_memory_map:
+                continue
+            if line and not line[0].isspace():
+                output_section = line.split()[0]
+                pending_name = None
+                continue
+            if output_section not in RAM_SECTIONS:
+                continue
+            match = INPUT_LINE.match(line)
+            if match:
+                name = match.group(1) or pending_name
+                pending_name = None
+                size = int(match.group(3), 16)
+                if name and size and not name.startswith("*"):
+                    sections.append((name, size, get_module(match.group(4))))
+                continue
+            # long section name is alone in line, address and size are in next one
+            stripped = line.strip()
+            pending_name = stripped if stripped.startswith((".", "COMMON")) and " " not in stripped else None
+    return sections
+
+
+def demangle(names):
+    """C++ names from avr-c++filt or c++filt, mangled names when tool is missing"""
+    for tool in ("avr-c++filt", "c++filt"):
+        try:
+            result = subprocess.run(
+                [tool], input="\n".join(names), capture_output=True, text=True, env=env["ENV"], check=True  # noqa: F821
+            )
+        except (OSError, subprocess.CalledProcessError):
+            continue
+        demangled = result.stdout.splitlines()
+        if len(demangled) == len(names):
+            return demangled
+    return names
+
+
+def read_progmem_names(source_dir):
+    """names of variables declared with PROGMEM in firmware sources, host tools are skipped"""
+    names = set()
+    for name in os.listdir(source_dir):
+        if name.endswith((".h", ".cpp")):
+            with open(os.path.join(source_dir, name), encoding="utf-8", errors="replace") as source:
+                names.update(PROGMEM_DECLARATION.findall(source.read()))
+    return names
+
+
+def read_symbols(elf_path):
+    """list of (address, size, demangled name) of sized symbols from avr-nm, empty when tool is missing"""
+    try:
+        result = subprocess.run(
+            ["avr-nm", "-C", "-S", elf_path], capture_output=True, text=True, env=env["ENV"], check=True  # noqa: F821
+        )
+    except (OSError, subprocess.CalledProcessError):
+        return []
+    symbols = []
+    for line in result.stdout.splitlines():
+        match = NM_LINE.match(line)
+        if match:
+            symbols.append((int(match.group(1), 16), int(match.group(2), 16), match.group(3)))
+    return symbols
+
+
+def check_progmem(elf_path):
+    """print flash tables, return names of PROGMEM variables placed in RAM"""
+    names = read_progmem_names(env.subst("$PROJECT_SRC_DIR"))  # noqa: F821
+    symbols = read_symbols(elf_path)
+    if not symbols:
+        print("PROGMEM check: no avr-nm output")
+        return []
+    tables = [symbol for symbol in symbols if symbol[2].split("::")[-1] in names]
+    in_ram = [name for address, _, name in tables if address >= RAM_ADDRESS]
+    print("PROGMEM variables:")
+    for address, size, name in sorted(tables, key=lambda symbol: -symbol[1]):
+        print("  %-48s %5d B  %s" % (name[:48], size, "RAM" if address >= RAM_ADDRESS else "flash"))
+    print("  %-48s %5d B" % ("total in flash", sum(size for address, size, _ in tables if address < RAM_ADDRESS)))
+    return in_ram
+
+
+def print_report(source, target, env):  # pylint: disable=unused-argument
+    in_ram = check_progmem(str(target[0]))
+    for name in in_ram:
+        print("Error: PROGMEM variable %s is in RAM" % name)
+    if not os.path.isfile(MAP_PATH):
+        print("RAM report: no linker map")
+        return 1 if in_ram else None
+    sections = read_ram_sections(MAP_PATH)
+    modules = {}
+    for _, size, module in sections:
+        modules[module] = modules.get(module, 0) + size
+    total = sum(modules.values())
+
+    print("")
+    print("Static RAM per module (.data + .bss + .noinit):")
+    for module, size in sorted(modules.items(), key=lambda item: -item[1]):
+        print("  %-32s %5d B %5.1f%%" % (module, size, 100.0 * size / RAM_SIZE))
+    print("  %-32s %5d B %5.1f%%" % ("total", total, 100.0 * total / RAM_SIZE))
+    print("  %-32s %5d B" % ("left for heap and stack", RAM_SIZE - total))
+
+    largest = sorted(sections, key=lambda section: -section[1])[:TOP_SYMBOLS]
+    names = [re.sub(r"^\.(data|bss|noinit)\.", "", name) for name, _, _ in largest]
+    print("Largest variables:")
+    for name, (_, size, module) in zip(demangle(names), largest):
+        print("  %-48s %5d B  %s" % (name[:48], size, module))
+    print("")
+    return 1 if in_ram else None
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", print_report)  # noqa: F821
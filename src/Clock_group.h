@@ -0,0 +1,269 @@
+/**
+ * @file Clock_group.h
+ * @brief Clocks of several cities driven by one loop, one RTC time and one WS2812 strip
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Config.h"
+#include "Dither.h"
+#include "Log.h"
+#include "RTClib.h"
+#include "Sky_bus.h"
+#include "Sun_clock.h"
+
+#include <stdint.h>
+
+const uint32_t ms_in_h = 3600000UL; ///< ms in hour
+
+/**
+ * @brief move time of day by whole hours
+ * @param now: time in ms from 0:00
+ * @param shift_h: hours, -26 to 26
+ * @return uint32_t time in ms from 0:00 of other timezone
+ */
+inline uint32_t shift_time_of_day(uint32_t now, int8_t shift_h)
+{
+  // two days keep sum positive for any timezone difference
+  return (now + 2 * ms_in_day + shift_h * static_cast<int32_t>(ms_in_h)) % ms_in_day;
+}
+
+/**
+ * @brief move date and time by whole hours
+ * @param time: time in home timezone
+ * @param shift_h: hours
+ * @return DateTime time in other timezone
+ */
+inline DateTime shift_datetime(const DateTime& time, int8_t shift_h)
+{
+  return DateTime(time.unixtime() + shift_h * 3600L);
+}
+
+///< clocks from index to end of policy list, each one is member of own type, no virtual calls
+template <uint8_t index, typename... Policies>
+class Clock_chain
+{
+public:
+  template <typename Function>
+  void for_each(Function&&, int8_t)
+  {}
+
+  template <typename Function>
+  void for_each(Function&&, int8_t) const
+  {}
+};
+
+template <uint8_t index, typename First, typename... Rest>
+class Clock_chain<index, First, Rest...>
+{
+public:
+  /**
+   * @brief call function for each clock in order of list
+   * @param function: called as function(clock, shift_h), shift_h is timezone difference to first clock
+   * @param home_tz: actual timezone of first clock, time of RTC
+   */
+  template <typename Function>
+  void for_each(Function&& function, int8_t home_tz)
+  {
+    function(m_clock, get_shift_h(home_tz));
+    m_rest.for_each(function, home_tz);
+  }
+
+  template <typename Function>
+  void for_each(Function&& function, int8_t home_tz) const
+  {
+    function(m_clock, get_shift_h(home_tz));
+    m_rest.for_each(function, home_tz);
+  }
+
+  /**
+   * @brief get actual timezone of clock, changed by tz command
+   * @return int8_t timezone offset in hours
+   */
+  int8_t get_tz_offset() const
+  {
+    return m_clock.get_location().tz_offset;
+  }
+
+private:
+  /**
+   * @brief hours from time of RTC, local time and sun events of clock follow tz command together
+   * @param home_tz: actual timezone of first clock
+   * @return int8_t timezone difference
+   */
+  int8_t get_shift_h(int8_t home_tz) const
+  {
+    return get_tz_offset() - home_tz;
+  }
+
+  Sun_clock<First> m_clock{index}; ///< clock of this policy
+  Clock_chain<index + 1, Rest...> m_rest; ///< next clocks
+};
+
+template <typename List>
+class Clock_group;
+
+/**
+ * @brief all clocks of Config::Clock_list, one animation frame calculates every clock and sends strip once
+ * @details cost of frame is sum of clocks, there is no clock which waits for other one, RTC time is time of first clock
+ */
+template <typename First, typename... Rest>
+class Clock_group<Config::Clock_list<First, Rest...>>
+{
+public:
+  static const uint8_t count = 1 + sizeof...(Rest); ///< clocks in group
+  static_assert(count <= Sky_bus::max_segments, "too many clocks for Sky_bus");
+
+  /**
+   * @brief call function for each clock
+   * @param function: called as function(clock, shift_h), shift_h is timezone difference to first clock
+   */
+  template <typename Function>
+  void for_each(Function&& function)
+  {
+    m_clocks.for_each(function, m_clocks.get_tz_offset());
+  }
+
+  template <typename Function>
+  void for_each(Function&& function) const
+  {
+    m_clocks.for_each(function, m_clocks.get_tz_offset());
+  }
+
+  /**
+   * @brief init pins of all clocks and shared strip
+   */
+  void init_outputs()
+  {
+    if constexpr (m_has_sky)
+    {
+      Sky_bus::begin();
+    }
+    for_each([](auto& clock, int8_t) { clock.init_outputs(); });
+  }
+
+  /**
+   * @brief make servo steps of all clocks, call in every loop pass
+   */
+  void update_servo()
+  {
+    for_each([](auto& clock, int8_t) { clock.update_servo(); });
+  }
+
+  /**
+   * @brief calculate and set outputs of all clocks, strip is sent once
+   * @param now: time of first clock in ms from 0:00
+   * @param is_logged: print colors on debug log
+   * @return uint32_t ms to next change of any clock
+   */
+  uint32_t render_frame(uint32_t now, bool is_logged)
+  {
+    if constexpr (Dither::is_enabled)
+    {
+      Dither::next_frame();
+    }
+    uint32_t time_to_change = ms_in_day;
+    for_each([&](auto& clock, int8_t shift_h) {
+      uint32_t local = shift_time_of_day(now, shift_h);
+      clock.render_frame(local, is_logged);
+      uint32_t clock_time_to_change = clock.get_next_change(local) - local;
+      if (clock_time_to_change < time_to_change)
+      {
+        time_to_change = clock_time_to_change;
+      }
+    });
+    show();
+    return time_to_change;
+  }
+
+  /**
+   * @brief check if any clock has dithered outputs
+   * @return true refresh_dither() should be called every dither_frame_time_ms
+   * @return false outputs of all clocks are static until next change
+   */
+  bool is_dithering() const
+  {
+    bool is_dithering = false;
+    for_each([&](const auto& clock, int8_t) { is_dithering |= clock.is_dithering(); });
+    return is_dithering;
+  }
+
+  /**
+   * @brief set last frame of all clocks again with next dither pattern, strip is sent once
+   */
+  void refresh_dither()
+  {
+    if constexpr (Dither::is_enabled)
+    {
+      Dither::next_frame();
+      for_each([](auto& clock, int8_t) { clock.refresh_dither(); });
+      show();
+    }
+  }
+
+  /**
+   * @brief check if outputs of all clocks keep state without timers
+   * @return true power down is possible
+   * @return false timers are needed
+   */
+  bool is_output_static() const
+  {
+    bool is_static = true;
+    for_each([&](const auto& clock, int8_t) { is_static &= clock.is_output_static(); });
+    return is_static;
+  }
+
+  /**
+   * @brief print committed and skipped updates of one clock on log
+   * @param index: clock index, one line for each clock so lines can wait for space in log buffer
+   */
+  void print_output_stats(uint8_t index) const
+  {
+    for_each([=](const auto& clock, int8_t) {
+      if (clock.get_index() != index)
+      {
+        return;
+      }
+      if (count > 1)
+      {
+        Log::out.print(F("clock "));
+        Log::out.print(clock.get_index());
+        Log::out.print(' ');
+      }
+      clock.print_output_stats();
+    });
+  }
+
+  /**
+   * @brief clear committed and skipped updates of one clock
+   * @param index: clock index
+   */
+  void reset_output_stats(uint8_t index)
+  {
+    for_each([=](auto& clock, int8_t) {
+      if (clock.get_index() == index)
+      {
+        clock.reset_output_stats();
+      }
+    });
+  }
+
+private:
+  static constexpr bool m_has_sky = First::has_sky || (Rest::has_sky || ...); ///< strip is used by any clock
+
+  /**
+   * @brief send strip with segments set in this frame
+   */
+  void show()
+  {
+    if constexpr (m_has_sky)
+    {
+      Sky_bus::show();
+    }
+  }
+
+  Clock_chain<0, First, Rest...> m_clocks; ///< clocks in order of list
+};
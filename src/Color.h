@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "Log.h"
+
 #include <stdint.h>
 
 ///< colors
@@ -20,7 +22,7 @@ enum class Colors
 
 struct Color
 {
-  Color(uint8_t _r = 0, uint8_t _g = 0, uint8_t _b = 0)
+  constexpr Color(uint8_t _r = 0, uint8_t _g = 0, uint8_t _b = 0)
   : r(_r)
   , g(_g)
   , b(_b)
@@ -41,15 +43,25 @@ struct Color
     return color;
   }
 
+  bool operator==(const Color& other) const
+  {
+    return r == other.r && g == other.g && b == other.b;
+  }
+
+  bool operator!=(const Color& other) const
+  {
+    return !(*this == other);
+  }
+
   void print_color() const
   {
-    Serial.print("color:");
-    Serial.print(get_color());
-    Serial.print(" r:");
-    Serial.print(r);
-    Serial.print(" g:");
-    Serial.print(g);
-    Serial.print(" b:");
-    Serial.println(b);
+    Log::out.print(F("color:"));
+    Log::out.print(get_color());
+    Log::out.print(F(" r:"));
+    Log::out.print(r);
+    Log::out.print(F(" g:"));
+    Log::out.print(g);
+    Log::out.print(F(" b:"));
+    Log::out.println(b);
   }
 };
\ No newline at end of file
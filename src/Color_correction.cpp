@@ -0,0 +1,54 @@
+/**
+ * @file Color_correction.cpp
+ * @brief Gamma and white balance tables for LED outputs
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Color_correction.h"
+
+#include "Config.h"
+
+#include <Arduino.h>
+
+namespace Color_correction
+{
+constexpr Table m_red PROGMEM = make_table(Config::gamma_red, Config::white_balance.r); ///< red channel
+constexpr Table m_green PROGMEM = make_table(Config::gamma_green, Config::white_balance.g); ///< green channel
+constexpr Table m_blue PROGMEM = make_table(Config::gamma_blue, Config::white_balance.b); ///< blue channel
+constexpr Wide_table m_wide_red PROGMEM = make_wide_table(Config::gamma_red, Config::white_balance.r); ///< red channel with fraction
+constexpr Wide_table m_wide_green PROGMEM = make_wide_table(Config::gamma_green, Config::white_balance.g); ///< green channel with fraction
+constexpr Wide_table m_wide_blue PROGMEM = make_wide_table(Config::gamma_blue, Config::white_balance.b); ///< blue channel with fraction
+
+uint8_t correct(Colors channel, uint8_t value)
+{
+  switch (channel)
+  {
+    case Colors::red:
+      return pgm_read_byte(&m_red.values[value]);
+    case Colors::green:
+      return pgm_read_byte(&m_green.values[value]);
+    default:
+      return pgm_read_byte(&m_blue.values[value]);
+  }
+}
+
+Color correct(const Color& color)
+{
+  return Color(pgm_read_byte(&m_red.values[color.r]), pgm_read_byte(&m_green.values[color.g]), pgm_read_byte(&m_blue.values[color.b]));
+}
+
+uint16_t correct_wide(Colors channel, uint8_t value)
+{
+  switch (channel)
+  {
+    case Colors::red:
+      return pgm_read_word(&m_wide_red.values[value]);
+    case Colors::green:
+      return pgm_read_word(&m_wide_green.values[value]);
+    default:
+      return pgm_read_word(&m_wide_blue.values[value]);
+  }
+}
+} // namespace Color_correction
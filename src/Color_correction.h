@@ -0,0 +1,88 @@
+/**
+ * @file Color_correction.h
+ * @brief Gamma and white balance tables for LED outputs
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "Const_math.h"
+
+#include <stdint.h>
+
+namespace Color_correction
+{
+const uint16_t table_size = 256; ///< one entry for each channel value
+const uint8_t fraction_bits = 2; ///< fraction bits of wide tables, 10 bit output for dithering, see Dither::pattern_length
+
+///< output value for each channel value
+struct Table
+{
+  uint8_t values[table_size];
+};
+
+/**
+ * @brief calculate table for one channel
+ * @param gamma: LED gamma, 1.0 = no correction
+ * @param white: output value for full channel, scales channel for white balance
+ * @return Table corrected values
+ */
+constexpr Table make_table(double gamma, uint8_t white)
+{
+  Table table{};
+  for (uint16_t i = 0; i < table_size; i++)
+  {
+    table.values[i] = static_cast<uint8_t>(white * Const_math::pow(static_cast<double>(i) / (table_size - 1), gamma) + 0.5);
+  }
+  return table;
+}
+
+///< output value with fraction for each channel value
+struct Wide_table
+{
+  uint16_t values[table_size];
+};
+
+/**
+ * @brief calculate table for one channel with fraction_bits below output value
+ * @param gamma: LED gamma, 1.0 = no correction
+ * @param white: output value for full channel, scales channel for white balance
+ * @return Wide_table corrected values in Q8.2
+ */
+constexpr Wide_table make_wide_table(double gamma, uint8_t white)
+{
+  Wide_table table{};
+  for (uint16_t i = 0; i < table_size; i++)
+  {
+    table.values[i] =
+        static_cast<uint16_t>((white << fraction_bits) * Const_math::pow(static_cast<double>(i) / (table_size - 1), gamma) + 0.5);
+  }
+  return table;
+}
+
+/**
+ * @brief correct one channel with table in flash
+ * @param channel: color channel
+ * @param value: perceived brightness
+ * @return uint8_t value for PWM or WS2812
+ */
+uint8_t correct(Colors channel, uint8_t value);
+
+/**
+ * @brief correct all channels with tables in flash
+ * @param color: perceived color
+ * @return Color color for PWM or WS2812
+ */
+Color correct(const Color& color);
+
+/**
+ * @brief correct one channel with wide table in flash, used by dithering
+ * @param channel: color channel
+ * @param value: perceived brightness
+ * @return uint16_t value for PWM or WS2812 in Q8.2
+ */
+uint16_t correct_wide(Colors channel, uint8_t value);
+} // namespace Color_correction
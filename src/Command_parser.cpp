@@ -0,0 +1,307 @@
+/**
+ * @file Command_parser.cpp
+ * @brief Line commands from Serial read few bytes at a time, without heap
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Command_parser.h"
+
+#include <Arduino.h>
+
+namespace
+{
+const uint8_t m_coordinate_decimals = 5; ///< same precision as location in Ephemeris_cache
+const uint8_t m_max_digits = 4; ///< digits before point, longest value is year, fixed point of coordinates fits in int32_t
+const uint8_t m_month_length[12] PROGMEM = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}; ///< days in months of common year
+
+void skip_spaces(const char*& text)
+{
+  while (*text == ' ')
+  {
+    text++;
+  }
+}
+
+/**
+ * @brief read keyword from flash followed by space or end of line
+ */
+bool match(const char*& text, const char* keyword)
+{
+  skip_spaces(text);
+  size_t length = strlen_P(keyword);
+  if (strncmp_P(text, keyword, length) != 0 || (text[length] != ' ' && text[length] != '\0'))
+  {
+    return false;
+  }
+  text += length;
+  return true;
+}
+
+/**
+ * @brief read one separator character
+ */
+bool expect(const char*& text, char separator)
+{
+  if (*text != separator)
+  {
+    return false;
+  }
+  text++;
+  return true;
+}
+
+/**
+ * @brief read decimal number as fixed point, digits after decimals are cut
+ * @param text: cursor, moved after number
+ * @param value: number * 10^decimals
+ * @param decimals: digits after point
+ * @return true number was read
+ * @return false no digits or too many digits before point
+ */
+bool parse_number(const char*& text, int32_t& value, uint8_t decimals = 0)
+{
+  skip_spaces(text);
+  bool is_negative = *text == '-';
+  if (*text == '-' || *text == '+')
+  {
+    text++;
+  }
+  if (*text < '0' || *text > '9')
+  {
+    return false;
+  }
+  int32_t result = 0;
+  for (uint8_t digits = 0; *text >= '0' && *text <= '9'; digits++)
+  {
+    if (digits == m_max_digits)
+    {
+      return false;
+    }
+    result = result * 10 + (*text++ - '0');
+  }
+  if (*text == '.')
+  {
+    text++;
+  }
+  for (uint8_t i = 0; i < decimals; i++)
+  {
+    result *= 10;
+    if (*text >= '0' && *text <= '9')
+    {
+      result += *text++ - '0';
+    }
+  }
+  while (*text >= '0' && *text <= '9')
+  {
+    text++;
+  }
+  value = is_negative ? -result : result;
+  return true;
+}
+
+/**
+ * @brief read number in range
+ */
+bool parse_range(const char*& text, int32_t& value, int32_t min, int32_t max)
+{
+  return parse_number(text, value) && value >= min && value <= max;
+}
+
+/**
+ * @brief days in month, every year from 2000 to 2099 divisible by 4 is leap
+ */
+uint8_t get_month_length(int32_t year, int32_t month)
+{
+  if (month == 2 && year % 4 == 0)
+  {
+    return 29;
+  }
+  return pgm_read_byte(&m_month_length[month - 1]);
+}
+
+bool is_end(const char* text)
+{
+  skip_spaces(text);
+  return *text == '\0';
+}
+
+bool parse_time(const char* text, Command& command)
+{
+  int32_t year, month, day, hour, minute, second;
+  if (!parse_range(text, year, 2000, 2099) || !expect(text, '-') || !parse_range(text, month, 1, 12) || !expect(text, '-') ||
+      !parse_range(text, day, 1, get_month_length(year, month)) || !parse_range(text, hour, 0, 23) || !expect(text, ':') ||
+      !parse_range(text, minute, 0, 59) || !expect(text, ':') || !parse_range(text, second, 0, 59))
+  {
+    return false;
+  }
+  command.time = DateTime(year, month, day, hour, minute, second);
+  return is_end(text);
+}
+
+bool parse_location(const char* text, Command& command)
+{
+  const int32_t scale = 100000L;
+  int32_t latitude, longitude;
+  if (!parse_number(text, latitude, m_coordinate_decimals) || !parse_number(text, longitude, m_coordinate_decimals) ||
+      latitude < -90 * scale || latitude > 90 * scale || longitude < -180 * scale || longitude > 180 * scale)
+  {
+    return false;
+  }
+  command.latitude = static_cast<double>(latitude) / scale;
+  command.longitude = static_cast<double>(longitude) / scale;
+  return is_end(text);
+}
+
+bool parse_timezone(const char* text, Command& command)
+{
+  int32_t tz_offset;
+  if (!parse_range(text, tz_offset, -12, 14))
+  {
+    return false;
+  }
+  command.tz_offset = tz_offset;
+  return is_end(text);
+}
+
+bool parse_color(const char* text, Command& command)
+{
+  int32_t keyframe, r, g, b;
+  if (!parse_range(text, keyframe, 0, 0xFF))
+  {
+    return false;
+  }
+  if (match(text, PSTR("sun")))
+  {
+    command.layer = Layer::sun;
+  }
+  else if (match(text, PSTR("east")))
+  {
+    command.layer = Layer::east;
+  }
+  else if (match(text, PSTR("zenith")))
+  {
+    command.layer = Layer::zenith;
+  }
+  else if (match(text, PSTR("west")))
+  {
+    command.layer = Layer::west;
+  }
+  else
+  {
+    return false;
+  }
+  if (!parse_range(text, r, 0, 0xFF) || !parse_range(text, g, 0, 0xFF) || !parse_range(text, b, 0, 0xFF))
+  {
+    return false;
+  }
+  command.keyframe = keyframe;
+  command.color = Color(r, g, b);
+  return is_end(text);
+}
+
+bool parse_clock(const char* text, Command& command)
+{
+  int32_t clock;
+  if (!parse_range(text, clock, 0, 0xFF))
+  {
+    return false;
+  }
+  command.clock = clock;
+  return is_end(text);
+}
+} // namespace
+
+Command Command_parser::update()
+{
+  for (uint8_t i = 0; i < max_bytes_per_update && Serial.available() > 0; i++)
+  {
+    char value = Serial.read();
+    m_last_input_ms = millis();
+    if (value != '\n' && value != '\r')
+    {
+      if (m_length < line_size - 1)
+      {
+        m_line[m_length++] = value;
+      }
+      else
+      {
+        m_is_overflow = true;
+      }
+      continue;
+    }
+
+    // "\r\n" gives empty line after command
+    if (m_length == 0 && !m_is_overflow)
+    {
+      continue;
+    }
+    m_line[m_length] = '\0';
+    Command command;
+    if (m_is_overflow)
+    {
+      command.type = Command_type::invalid;
+    }
+    else
+    {
+      command = parse();
+    }
+    m_length = 0;
+    m_is_overflow = false;
+    return command;
+  }
+  return Command();
+}
+
+unsigned long Command_parser::get_last_input_ms() const
+{
+  return m_last_input_ms;
+}
+
+Command Command_parser::parse() const
+{
+  Command command;
+  command.type = Command_type::invalid;
+  const char* text = m_line;
+  if (match(text, PSTR("time")))
+  {
+    if (parse_time(text, command))
+    {
+      command.type = Command_type::time;
+    }
+  }
+  else if (match(text, PSTR("loc")))
+  {
+    if (parse_location(text, command))
+    {
+      command.type = Command_type::location;
+    }
+  }
+  else if (match(text, PSTR("tz")))
+  {
+    if (parse_timezone(text, command))
+    {
+      command.type = Command_type::timezone;
+    }
+  }
+  else if (match(text, PSTR("color")))
+  {
+    if (parse_color(text, command))
+    {
+      command.type = Command_type::color;
+    }
+  }
+  else if (match(text, PSTR("clock")))
+  {
+    if (parse_clock(text, command))
+    {
+      command.type = Command_type::clock;
+    }
+  }
+  else if (match(text, PSTR("p")) && is_end(text))
+  {
+    command.type = Command_type::profile;
+  }
+  return command;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file Command_parser.h
+ * @brief Line commands from Serial read few bytes at a time, without heap
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "RTClib.h"
+#include "Timeline.h"
+
+#include <stdint.h>
+
+///< command from one line
+enum class Command_type : uint8_t
+{
+  none, ///< line is not complete
+  invalid, ///< unknown command, wrong value or too long line
+  time, ///< time Y-M-D h:m:s, day is checked with length of month
+  location, ///< loc latitude longitude
+  timezone, ///< tz hours
+  color, ///< color keyframe sun|east|zenith|west r g b
+  clock, ///< clock index, selects clock for loc, tz and color
+  profile ///< p
+};
+
+///< parsed command, only values of command type are set
+struct Command
+{
+  Command_type type = Command_type::none;
+  DateTime time; ///< new RTC time
+  double latitude = 0; ///< degrees
+  double longitude = 0; ///< degrees
+  int8_t tz_offset = 0; ///< hours
+  uint8_t keyframe = 0; ///< keyframe index
+  Layer layer = Layer::sun; ///< changed color of keyframe
+  Color color; ///< new color
+  uint8_t clock = 0; ///< selected clock index
+};
+
+class Command_parser
+{
+public:
+  static const uint8_t line_size = 40; ///< longest line with '\0'
+  static const uint8_t max_bytes_per_update = 16; ///< bytes read in one update(), UART RX buffer keeps rest
+
+  /**
+   * @brief read bytes which are already received, never waits
+   * @return Command parsed command when line ended with '\n' or '\r', type none otherwise
+   */
+  Command update();
+
+  /**
+   * @brief get time of last received byte
+   * @return unsigned long millis() of last byte
+   */
+  unsigned long get_last_input_ms() const;
+
+private:
+  /**
+   * @brief parse complete line
+   * @return Command parsed command, invalid when line does not match any command
+   */
+  Command parse() const;
+
+  char m_line[line_size]; ///< actual line
+  uint8_t m_length = 0; ///< bytes in actual line
+  bool m_is_overflow = false; ///< actual line did not fit, it is invalid
+  unsigned long m_last_input_ms = 0; ///< millis() of last byte
+};
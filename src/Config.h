@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Color.h"
+#include "Easing.h"
+#include "Timeline.h"
 
 #include <stdint.h>
 
@@ -19,19 +21,113 @@ const uint8_t pin_led_r = 3; ///< red pin in RGB LED
 const uint8_t pin_led_g = 5; ///< green pin in RGB LED
 const uint8_t pin_led_b = 6; ///< blue pin in RGB LED
 const uint8_t led_ws = 7; ///< pin for WS2812 LED
-const uint8_t led_ws_count = 10; ///< WS2812 LED count
+const uint8_t pin_rtc_sqw = 2; ///< pin with DS1307 SQW/OUT (1 Hz), must be 0 - 7 for pin change interrupt
+const uint16_t led_ws_count = 10; ///< WS2812 LED count, above 300 only with SUN_CLOCK_SKY_STREAM
 const uint8_t min_servo_pos = 0; ///< minimal servo position
 const uint8_t max_servo_pos = 180; ///< maximum servo position
 const uint16_t serial_baudrate = 9600; ///< serial baudrate
 
-const unsigned long m_refresh_time_ms = 30000; ///< refrishing time in main loop
-const uint16_t time_for_servo_move = 300; ///< time from set PWM to turn off
+const unsigned long m_refresh_time_ms = 30000; ///< time between logs in main loop
+const uint32_t rtc_sync_time_s = 3600; ///< time between RTC reads, between them time is counted from SQW
+const uint8_t frame_time_ms = 20; ///< time between animation frames, 50 Hz
+const uint16_t frame_budget_us = 5000; ///< CPU time for one animation frame
+const uint16_t loop_deadline_us = 20000; ///< loop() longer than this delays next frame, counted with SUN_CLOCK_PROFILE
+const uint8_t dither_frame_time_ms = 4; ///< time between dither frames with SUN_CLOCK_DITHER, full pattern of 4 frames at 62.5 Hz
+const uint16_t dither_budget_us = 1000; ///< CPU time for one dither frame, strip transmission is checked during compilation
+const uint8_t dither_max_output = 32; ///< dark outputs below this value are dithered, brighter ones are rounded and static
+const uint16_t command_awake_ms = 10000; ///< no power down after byte on Serial, UART does not receive in power down
+const uint16_t time_for_servo_move = 300; ///< time from end of move to turn off PWM
+const uint16_t servo_min_pulse_us = 544; ///< servo pulse for 0 degrees
+const uint16_t servo_max_pulse_us = 2400; ///< servo pulse for 180 degrees
+const uint16_t servo_max_speed = 400; ///< servo pulse change in us per s, about 40 degrees per s
+const uint16_t servo_max_acceleration = 800; ///< servo pulse change in us per s^2, full speed after 0.5 s
+const uint16_t servo_min_step_us = 4; ///< smaller servo target change is skipped, below dead band of typical servo (about 0.4 degree)
 
-const double latitude = 51.1078852; ///< latitude loaction
-const double longitude = 17.0385376; ///< longitude loaction
+constexpr double latitude = 51.1078852; ///< latitude loaction
+constexpr double longitude = 17.0385376; ///< longitude loaction
 const int8_t dst_offset = 2; ///< daylight saving time offset
+const int ephemeris_year = 2024; ///< leap year for which sunrise/sunset table is calculated
+const uint8_t ephemeris_cache_address = 0; ///< address of sun events in DS1307 RAM, used with SUN_CLOCK_RUNTIME_EPHEMERIS
 
-const Color horizon_sun(27, 4, 0); ///< sun color when it's on horizon
-const Color noon(255, 200, 0); ///< sun color when is noon
-const Color blue_sky(0, 5, 12); ///< sky color on day
+constexpr double gamma_red = 2.2; ///< LED gamma for red channel
+constexpr double gamma_green = 2.2; ///< LED gamma for green channel
+constexpr double gamma_blue = 2.2; ///< LED gamma for blue channel
+constexpr Color white_balance(255, 255, 255); ///< output for full channels, lower channels which are too strong in white
+
+// colors are perceived brightness, LED outputs are corrected by gamma
+constexpr Color night(0, 0, 0); ///< sun and sky color on night
+constexpr Color horizon_sun(92, 37, 0); ///< sun color when it's on horizon
+constexpr Color noon(255, 229, 0); ///< sun color when is noon
+constexpr Color blue_sky(0, 41, 63); ///< sky color on day
+constexpr Color glow_sky = Sky_renderer::add(blue_sky, horizon_sun); ///< horizon on the sun side on sunrise and sunset
+
+const Easing::Curve sunrise_easing = Easing::Curve::sine; ///< curve from civil sunrise to sunrise
+const Easing::Curve morning_easing = Easing::Curve::linear; ///< curve from sunrise to noon
+const Easing::Curve afternoon_easing = Easing::Curve::linear; ///< curve from noon to sunset
+const Easing::Curve sunset_easing = Easing::Curve::sine; ///< curve from sunset to civil sunset
+
+const int16_t glow_time = 30; ///< minutes after sunrise and before sunset with warm horizon
+const Easing::Curve glow_easing = Easing::Curve::sine; ///< curve of horizon glow fading
+
+const uint8_t auto_sun_servo = Timeline::interpolate_sun | Timeline::interpolate_servo; ///< sun and servo follow neighbour keyframes
+
+// keyframes of day sorted by time, new keyframe (e.g. golden hour or nautical twilight) is one more line
+// anchor, offset in minutes, {sun, {sky east, zenith, west}, servo}, sun easing, sky easing, interpolated values
+constexpr Keyframe_config keyframes[] PROGMEM = {
+    {Sun_event::sunrise_civil, 0, {night, {night, night, night}, min_servo_pos}, sunrise_easing, sunrise_easing, 0},
+    {Sun_event::sunrise, 0, {horizon_sun, {glow_sky, blue_sky, blue_sky}, min_servo_pos}, morning_easing, glow_easing, 0},
+    {Sun_event::sunrise, glow_time, {night, {blue_sky, blue_sky, blue_sky}, 0}, morning_easing, Easing::Curve::linear, auto_sun_servo},
+    {Sun_event::noon, 0, {noon, {blue_sky, blue_sky, blue_sky}, 0}, afternoon_easing, Easing::Curve::linear, Timeline::interpolate_servo},
+    {Sun_event::sunset, -glow_time, {night, {blue_sky, blue_sky, blue_sky}, 0}, afternoon_easing, glow_easing, auto_sun_servo},
+    {Sun_event::sunset, 0, {horizon_sun, {blue_sky, blue_sky, glow_sky}, max_servo_pos}, sunset_easing, sunset_easing, 0},
+    {Sun_event::sunset_civil, 0, {night, {night, night, night}, max_servo_pos}, Easing::Curve::linear, Easing::Curve::linear, 0},
+};
+const uint8_t keyframe_count = sizeof(keyframes) / sizeof(keyframes[0]); ///< number of keyframes
+
+///< outputs and day of clock, all values are folded into Sun_clock<Clock_policy> during compilation
+struct Clock_policy
+{
+  static constexpr bool has_servo = true; ///< sun is moved by servo, false removes servo code
+  static constexpr bool has_sky = true; ///< WS2812 sky strip, false removes strip code
+  static constexpr uint8_t pin_led_r = Config::pin_led_r; ///< red pin in RGB LED
+  static constexpr uint8_t pin_led_g = Config::pin_led_g; ///< green pin in RGB LED
+  static constexpr uint8_t pin_led_b = Config::pin_led_b; ///< blue pin in RGB LED
+  static constexpr uint8_t pin_servo = Config::pin_servo; ///< pin to controll pwm for servo
+  static constexpr uint16_t servo_move_time_ms = time_for_servo_move; ///< time from end of move to turn off PWM
+  static constexpr uint16_t servo_min_pulse_us = Config::servo_min_pulse_us; ///< servo pulse for 0 degrees
+  static constexpr uint16_t servo_max_pulse_us = Config::servo_max_pulse_us; ///< servo pulse for 180 degrees
+  static constexpr uint16_t servo_max_speed = Config::servo_max_speed; ///< servo pulse change in us per s
+  static constexpr uint16_t servo_max_acceleration = Config::servo_max_acceleration; ///< servo pulse change in us per s^2
+  static constexpr uint16_t servo_min_step_us = Config::servo_min_step_us; ///< smaller servo target change is skipped
+  static constexpr uint16_t sky_first = 0; ///< first pixel of sky on shared WS2812 strip
+  static constexpr uint16_t sky_count = led_ws_count; ///< WS2812 LED count of sky
+  static constexpr double latitude = Config::latitude; ///< latitude of sun events
+  static constexpr double longitude = Config::longitude; ///< longitude of sun events
+  static constexpr int8_t tz_offset = dst_offset; ///< timezone of sun events
+  static constexpr const Keyframe_config* keyframes = Config::keyframes; ///< keyframes of day in flash
+  static constexpr uint8_t keyframe_count = Config::keyframe_count; ///< number of keyframes
+};
+
+// second city on same MCU: own RGB pins and part of strip, time is shifted by tz_offset difference to first clock
+// led_ws_count has to cover both segments, sky_count of Clock_policy is then first part of strip
+// struct Tokyo_policy : Clock_policy
+// {
+//   static constexpr bool has_servo = false;
+//   static constexpr uint8_t pin_led_r = 11; ///< last free PWM pin on Nano, pin 10 PWM is taken by Servo timer
+//   static constexpr uint8_t pin_led_g = 12; ///< on/off only
+//   static constexpr uint8_t pin_led_b = 13; ///< on/off only
+//   static constexpr uint16_t sky_first = 10;
+//   static constexpr uint16_t sky_count = 10;
+//   static constexpr double latitude = 35.6762;
+//   static constexpr double longitude = 139.6503;
+//   static constexpr int8_t tz_offset = 9;
+// };
+
+///< list of clock policies driven by one loop
+template <typename... Policies>
+struct Clock_list
+{};
+
+// e.g. Clock_list<Clock_policy, Tokyo_policy>
+typedef Clock_list<Clock_policy> clocks; ///< clocks on this MCU, first one gives home time of RTC
 } // namespace Config
\ No newline at end of file
@@ -0,0 +1,231 @@
+/**
+ * @file Const_math.h
+ * @brief Math functions evaluated during compilation
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+// templates over real type, host tools repeat in float what avr-gcc calculates with 32 bit double;
+// constants are converted to Real, on AVR double literal has float precision too
+namespace Const_math
+{
+constexpr double pi = 3.14159265358979323846;
+
+template <typename Real>
+constexpr Real floor(Real x)
+{
+  long i = static_cast<long>(x);
+  return (x < i) ? Real(i - 1) : Real(i);
+}
+
+template <typename Real>
+constexpr Real abs(Real x)
+{
+  return (x < 0) ? -x : x;
+}
+
+template <typename Real>
+constexpr Real deg_to_rad(Real angle)
+{
+  return Real(pi) * angle / Real(180.0);
+}
+
+template <typename Real>
+constexpr Real rad_to_deg(Real angle)
+{
+  return Real(180.0) * angle / Real(pi);
+}
+
+/**
+ * @brief reduce angle to range -180..180
+ * @param angle: angle in degrees
+ * @return Real reduced angle
+ */
+template <typename Real>
+constexpr Real reduce_deg(Real angle)
+{
+  return angle - Real(360.0) * floor((angle + Real(180.0)) / Real(360.0));
+}
+
+/**
+ * @brief sinus from Taylor series
+ * @param angle: angle in degrees
+ * @return Real sinus value
+ */
+template <typename Real>
+constexpr Real sin_deg(Real angle)
+{
+  angle = reduce_deg(angle);
+  if (angle > Real(90.0))
+  {
+    angle = Real(180.0) - angle;
+  }
+  else if (angle < Real(-90.0))
+  {
+    angle = Real(-180.0) - angle;
+  }
+  Real x = deg_to_rad(angle);
+  Real term = x;
+  Real sum = x;
+  for (int i = 1; i < 10; i++)
+  {
+    term *= -x * x / ((2 * i) * (2 * i + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+template <typename Real>
+constexpr Real cos_deg(Real angle)
+{
+  return sin_deg(angle + Real(90.0));
+}
+
+template <typename Real>
+constexpr Real tan_deg(Real angle)
+{
+  return sin_deg(angle) / cos_deg(angle);
+}
+
+template <typename Real>
+constexpr Real sqrt(Real x)
+{
+  if (x <= 0)
+  {
+    return 0;
+  }
+  Real y = (x > 1) ? x : 1;
+  for (int i = 0; i < 40; i++)
+  {
+    y = Real(0.5) * (y + x / y);
+  }
+  return y;
+}
+
+/**
+ * @brief arcus tangent from Taylor series, argument halved until series converge fast
+ * @param x: tangent value
+ * @return Real angle in radians
+ */
+template <typename Real>
+constexpr Real atan(Real x)
+{
+  if (abs(x) > 1)
+  {
+    return ((x > 0) ? Real(pi / 2) : Real(-pi / 2)) - atan(1 / x);
+  }
+  int halvings = 0;
+  while (abs(x) > Real(0.1))
+  {
+    x = x / (1 + sqrt(1 + x * x));
+    halvings++;
+  }
+  Real term = x;
+  Real sum = x;
+  for (int i = 1; i < 8; i++)
+  {
+    term *= -x * x;
+    sum += term / (2 * i + 1);
+  }
+  return sum * (1 << halvings);
+}
+
+template <typename Real>
+constexpr Real asin(Real x)
+{
+  if (x >= 1)
+  {
+    return Real(pi / 2);
+  }
+  if (x <= -1)
+  {
+    return Real(-pi / 2);
+  }
+  return atan(x / sqrt(1 - x * x));
+}
+
+template <typename Real>
+constexpr Real acos(Real x)
+{
+  return Real(pi / 2) - asin(x);
+}
+
+/**
+ * @brief exponential function from Taylor series, argument halved until series converge fast
+ * @param x: exponent
+ * @return Real e^x
+ */
+template <typename Real>
+constexpr Real exp(Real x)
+{
+  int halvings = 0;
+  while (abs(x) > Real(0.5))
+  {
+    x /= 2;
+    halvings++;
+  }
+  Real term = 1;
+  Real sum = 1;
+  for (int i = 1; i < 12; i++)
+  {
+    term *= x / i;
+    sum += term;
+  }
+  for (int i = 0; i < halvings; i++)
+  {
+    sum *= sum;
+  }
+  return sum;
+}
+
+/**
+ * @brief natural logarithm from atanh series, argument scaled by powers of 2 to range 0.75-1.5
+ * @param x: argument, x > 0
+ * @return Real ln(x)
+ */
+template <typename Real>
+constexpr Real ln(Real x)
+{
+  constexpr double ln_2 = 0.69314718055994530942;
+  int exponent = 0;
+  while (x > Real(1.5))
+  {
+    x /= 2;
+    exponent++;
+  }
+  while (x < Real(0.75))
+  {
+    x *= 2;
+    exponent--;
+  }
+  Real y = (x - 1) / (x + 1);
+  Real y2 = y * y;
+  Real term = y;
+  Real sum = 0;
+  for (int i = 1; i < 30; i += 2)
+  {
+    sum += term / i;
+    term *= y2;
+  }
+  return 2 * sum + exponent * Real(ln_2);
+}
+
+/**
+ * @brief power with real exponent
+ * @param base: base, base >= 0
+ * @param exponent: exponent
+ * @return Real base^exponent
+ */
+template <typename Real>
+constexpr Real pow(Real base, Real exponent)
+{
+  if (base <= 0)
+  {
+    return 0;
+  }
+  return exp(exponent * ln(base));
+}
+} // namespace Const_math
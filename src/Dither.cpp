@@ -0,0 +1,95 @@
+/**
+ * @file Dither.cpp
+ * @brief Temporal dithering of dark outputs to 10 bit colors, compiled only with SUN_CLOCK_DITHER
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Dither.h"
+
+#ifdef SUN_CLOCK_DITHER
+
+#include "Color_correction.h"
+#include "Config.h"
+
+#include <Arduino.h>
+
+namespace Dither
+{
+namespace
+{
+const uint8_t m_fraction_mask = (1 << Color_correction::fraction_bits) - 1;
+const uint16_t m_max_dithered = Config::dither_max_output << Color_correction::fraction_bits; ///< brighter values are rounded
+const uint8_t m_pixel_shift = 3; ///< pattern shift between neighbour pixels, odd so all steps are used
+
+static_assert(pattern_length == 1 << Color_correction::fraction_bits, "pattern has one step for each fraction");
+static_assert(1000 / (Config::dither_frame_time_ms * pattern_length) >= min_flicker_hz, "dither pattern flickers, use shorter frames");
+
+// bit reversed counter, every fraction is spread evenly over pattern, 1/2 is on in every second frame
+constexpr uint8_t m_thresholds[pattern_length] PROGMEM = {0, 2, 1, 3};
+
+uint8_t m_phase = 0; ///< step of pattern
+bool m_is_active = false; ///< output with fraction since last take_active()
+
+/**
+ * @brief check if value needs dithering, also marks frame as active
+ */
+bool is_dithered(uint16_t wide)
+{
+  if (wide >= m_max_dithered || (wide & m_fraction_mask) == 0)
+  {
+    return false;
+  }
+  m_is_active = true;
+  return true;
+}
+
+/**
+ * @brief round wide value to output value
+ */
+uint8_t round_output(uint16_t wide)
+{
+  uint16_t value = (wide + (m_fraction_mask + 1) / 2) >> Color_correction::fraction_bits;
+  return (value > 0xFF) ? 0xFF : value;
+}
+} // namespace
+
+void next_frame()
+{
+  m_phase = (m_phase + 1) & (pattern_length - 1);
+}
+
+bool take_active()
+{
+  bool is_active = m_is_active;
+  m_is_active = false;
+  return is_active;
+}
+
+uint8_t correct(Colors channel, uint8_t value, uint16_t pixel)
+{
+  uint16_t wide = Color_correction::correct_wide(channel, value);
+  if (!is_dithered(wide))
+  {
+    return round_output(wide);
+  }
+  uint8_t threshold = pgm_read_byte(&m_thresholds[(m_phase + pixel * m_pixel_shift) & (pattern_length - 1)]);
+  return (wide + threshold) >> Color_correction::fraction_bits;
+}
+
+uint8_t diffuse(Colors channel, uint8_t value, uint8_t& residual)
+{
+  uint16_t wide = Color_correction::correct_wide(channel, value);
+  if (!is_dithered(wide))
+  {
+    residual = 0;
+    return round_output(wide);
+  }
+  wide += residual;
+  residual = wide & m_fraction_mask;
+  return wide >> Color_correction::fraction_bits;
+}
+} // namespace Dither
+
+#endif
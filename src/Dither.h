@@ -0,0 +1,62 @@
+/**
+ * @file Dither.h
+ * @brief Temporal dithering of dark outputs to 10 bit colors, compiled only with SUN_CLOCK_DITHER
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+// Output has 2 bits below 8 bit value (Q8.2), perceived colors from Timeline and Sky_renderer stay 8 bit, only gamma tables are wide.
+// 12 bits (16 bit internal color) is out of scope: 4 fraction bits need 16 frame pattern, which repeats at 15.6 Hz with 4 ms frames,
+// and 1 ms frames do not fit next to animation frames (frame_budget_us) and WS2812 latch. Lowest repeat of any value measured on host
+// for every channel value and pixel is 62.5 Hz (1/4 and 3/4), 1/2 repeats at 125 Hz.
+
+#pragma once
+
+#include "Color.h"
+
+#include <stdint.h>
+
+namespace Dither
+{
+#ifdef SUN_CLOCK_DITHER
+constexpr bool is_enabled = true; ///< dark outputs are dithered
+#else
+constexpr bool is_enabled = false; ///< outputs use 8 bit gamma tables, dithering is removed by compiler
+#endif
+
+const uint8_t pattern_length = 4; ///< frames of full pattern, one for each fraction value, longer pattern repeats below min_flicker_hz
+const uint8_t min_flicker_hz = 60; ///< lowest frequency of on/off pattern of any fraction, 1/4 and 3/4 repeat with whole pattern
+const uint8_t ws2812_pixel_us = 30; ///< WS2812 transmission of one pixel, used for dither frame budget
+
+/**
+ * @brief start next dither frame, pattern moves by one step, call once for all clocks
+ */
+void next_frame();
+
+/**
+ * @brief check if any output since last call was dithered, flag is cleared
+ * @details called after outputs of each clock, so every clock knows only about own outputs
+ * @return true outputs change in next dither frame
+ * @return false outputs are static
+ */
+bool take_active();
+
+/**
+ * @brief correct strip pixel channel with ordered pattern, no state per pixel
+ * @param channel: color channel
+ * @param value: perceived brightness
+ * @param pixel: pixel index, neighbour pixels get shifted pattern
+ * @return uint8_t value for WS2812
+ */
+uint8_t correct(Colors channel, uint8_t value, uint16_t pixel);
+
+/**
+ * @brief correct channel with error diffusion, rest of fraction is added in next frame
+ * @param channel: color channel
+ * @param value: perceived brightness
+ * @param residual: fraction not sent yet, updated
+ * @return uint8_t value for PWM
+ */
+uint8_t diffuse(Colors channel, uint8_t value, uint8_t& residual);
+} // namespace Dither
@@ -0,0 +1,47 @@
+/**
+ * @file Easing.cpp
+ * @brief Easing curves lookup tables
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Easing.h"
+
+#include <Arduino.h>
+
+namespace Easing
+{
+constexpr Table m_sine PROGMEM = make_table(Curve::sine); ///< 1 - cos(x * pi / 2)
+constexpr Table m_smoothstep PROGMEM = make_table(Curve::smoothstep); ///< 3x^2 - 2x^3
+constexpr Table m_exponential PROGMEM = make_table(Curve::exponential); ///< (e^(ax) - 1) / (e^a - 1)
+
+uint16_t ease(Curve curve, uint16_t x)
+{
+  const Table* table;
+  switch (curve)
+  {
+    case Curve::sine:
+      table = &m_sine;
+      break;
+    case Curve::smoothstep:
+      table = &m_smoothstep;
+      break;
+    case Curve::exponential:
+      table = &m_exponential;
+      break;
+    default:
+      return x;
+  }
+
+  if (x >= Fixed_point::q15_one)
+  {
+    return Fixed_point::q15_one;
+  }
+  uint8_t index = x >> table_shift;
+  uint8_t rest = x & ((1 << table_shift) - 1);
+  uint16_t low = pgm_read_word(&table->values[index]);
+  uint16_t high = (index == table_size - 1) ? Fixed_point::q15_one : pgm_read_word(&table->values[index + 1]);
+  return low + ((static_cast<uint32_t>(high - low) * rest) >> table_shift);
+}
+} // namespace Easing
@@ -0,0 +1,123 @@
+/**
+ * @file Easing.h
+ * @brief Easing curves for color transitions
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Const_math.h"
+#include "Fixed_point.h"
+
+#include <stdint.h>
+
+namespace Easing
+{
+///< easing curve, defined from dark to bright
+enum class Curve : uint8_t
+{
+  linear,
+  sine,
+  smoothstep,
+  exponential
+};
+
+const uint16_t table_size = 256; ///< entries in lookup table
+const uint8_t table_shift = Fixed_point::q15_shift - 8; ///< input bits between table entries
+constexpr double exponential_rate = 4.0; ///< steepness of exponential curve
+
+///< curve samples for inputs 0 - 255/256, output Q15
+struct Table
+{
+  uint16_t values[table_size];
+};
+
+/**
+ * @brief curve value for table generation
+ * @param curve: easing curve
+ * @param x: input 0 - 1.0
+ * @return double output 0 - 1.0
+ */
+constexpr double curve_value(Curve curve, double x)
+{
+  switch (curve)
+  {
+    case Curve::sine:
+      return 1.0 - Const_math::cos_deg(x * 90.0);
+    case Curve::smoothstep:
+      return x * x * (3.0 - 2.0 * x);
+    case Curve::exponential:
+      return (Const_math::exp(exponential_rate * x) - 1.0) / (Const_math::exp(exponential_rate) - 1.0);
+    default:
+      return x;
+  }
+}
+
+/**
+ * @brief generate lookup table for curve
+ * @param curve: easing curve
+ * @return Table curve samples
+ */
+constexpr Table make_table(Curve curve)
+{
+  Table table{};
+  for (uint16_t i = 0; i < table_size; i++)
+  {
+    table.values[i] = static_cast<uint16_t>(curve_value(curve, static_cast<double>(i) / table_size) * Fixed_point::q15_one + 0.5);
+  }
+  return table;
+}
+
+/**
+ * @brief evaluate curve from table in flash, linear interpolation between entries
+ * @param curve: easing curve
+ * @param x: input Q15, 0 - 1.0
+ * @return uint16_t output Q15, 0 - 1.0
+ */
+uint16_t ease(Curve curve, uint16_t x);
+
+/**
+ * @brief upper bound of curve slope, used to estimate time of next output change
+ * @param curve: easing curve
+ * @return uint8_t maximum of d(output)/d(input), rounded up
+ */
+inline uint8_t max_slope(Curve curve)
+{
+  switch (curve)
+  {
+    case Curve::sine:
+      return 2; // pi / 2
+    case Curve::smoothstep:
+      return 2; // 1.5
+    case Curve::exponential:
+      return 5; // a * e^a / (e^a - 1) = 4.07
+    default:
+      return 1;
+  }
+}
+
+/**
+ * @brief interpolate channel between two values, curve is applied from darker to brighter value
+ * @param from: value on start
+ * @param to: value on end
+ * @param progress: progress from start to end
+ * @param curve: easing curve
+ * @return uint8_t interpolated value
+ */
+inline uint8_t ease_channel(uint8_t from, uint8_t to, const Fixed_point::Progress& progress, Curve curve)
+{
+  uint8_t value = Fixed_point::lerp(from, to, progress);
+  if (curve == Curve::linear || from == to)
+  {
+    return value;
+  }
+  uint8_t dark = (from < to) ? from : to;
+  uint8_t delta = (from < to) ? to - from : from - to;
+  // 16 bit division, Q8 fraction is enough for 8 bit output
+  uint16_t fraction = ((static_cast<uint16_t>(value - dark) << 8) + (delta >> 1)) / delta;
+  uint16_t eased = ease(curve, fraction << table_shift);
+  return dark + ((static_cast<uint32_t>(delta) * eased) >> Fixed_point::q15_shift);
+}
+} // namespace Easing
@@ -0,0 +1,21 @@
+/**
+ * @file Ephemeris.cpp
+ * @brief Reading sunrise and sunset tables from flash
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Ephemeris.h"
+
+#include <Arduino.h>
+
+namespace Ephemeris
+{
+Day_events get_day_events(const Year_table& table, uint8_t month, uint8_t day)
+{
+  Day_events events;
+  memcpy_P(&events, &table.days[day_of_year(month, day)], sizeof(Day_events));
+  return events;
+}
+} // namespace Ephemeris
@@ -0,0 +1,297 @@
+/**
+ * @file Ephemeris.h
+ * @brief Sunrise and sunset times calculated during compilation
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Const_math.h"
+
+#include <stdint.h>
+
+namespace Ephemeris
+{
+const uint16_t days_in_table = 366; ///< one entry for each day of leap year
+const uint16_t min_in_day = 1440; ///< minutes in day
+
+constexpr double official_zenith = 90.833; ///< sun zenith angle for sunrise/sunset
+constexpr double civil_zenith = 96; ///< sun zenith angle for civil sunrise/sunset
+
+///< sun events for one day, time in minutes from 0:00
+struct Day_events
+{
+  uint16_t sunrise_civil;
+  uint16_t sunrise;
+  uint16_t sunset;
+  uint16_t sunset_civil;
+};
+
+///< place for which events are calculated
+struct Location
+{
+  double latitude; ///< degrees, north is positive
+  double longitude; ///< degrees, east is positive
+  int8_t tz_offset; ///< timezone offset in hours, events are in this local time
+};
+
+///< events for every day of year
+struct Year_table
+{
+  Day_events days[days_in_table];
+};
+
+/**
+ * @brief calculate Julian centuries from J2000.0
+ * @param days: days from J2000.0 (2000-01-01 12:00 UTC)
+ * @return Real Julian centuries
+ */
+template <typename Real>
+constexpr Real calc_time_julian_cent(Real days)
+{
+  return days / Real(36525.0);
+}
+
+/**
+ * @brief calculate days from J2000.0 to midnight UTC of date
+ * @param year: year
+ * @param month: month 1-12
+ * @param day: day of month 1-31
+ * @return Real days from J2000.0
+ */
+template <typename Real = double>
+constexpr Real calc_days_from_j2000(int year, int month, int day)
+{
+  if (month <= 2)
+  {
+    year -= 1;
+    month += 12;
+  }
+  long a = year / 100;
+  long b = 2 - a + a / 4;
+  long jd_day = (1461L * (year + 4716)) / 4 + (306001L * (month + 1)) / 10000 + day + b;
+  // JD = jd_day - 1524.5, J2000.0 = 2451545.0
+  return static_cast<Real>(jd_day - 2453069L) - Real(0.5);
+}
+
+template <typename Real>
+constexpr Real calc_geom_mean_long_sun(Real t)
+{
+  return Const_math::reduce_deg(Real(280.46646) + t * (Real(36000.76983) + Real(0.0003032) * t));
+}
+
+template <typename Real>
+constexpr Real calc_geom_mean_anomaly_sun(Real t)
+{
+  return Const_math::reduce_deg(Real(357.52911) + t * (Real(35999.05029) - Real(0.0001537) * t));
+}
+
+template <typename Real>
+constexpr Real calc_eccentricity_earth_orbit(Real t)
+{
+  return Real(0.016708634) - t * (Real(0.000042037) + Real(0.0000001267) * t);
+}
+
+template <typename Real>
+constexpr Real calc_obliquity_correction(Real t)
+{
+  Real seconds = Real(21.448) - t * (Real(46.8150) + t * (Real(0.00059) - t * Real(0.001813)));
+  Real e0 = Real(23.0) + (Real(26.0) + (seconds / Real(60.0))) / Real(60.0);
+  Real omega = Real(125.04) - Real(1934.136) * t;
+  return e0 + Real(0.00256) * Const_math::cos_deg(omega);
+}
+
+template <typename Real>
+constexpr Real calc_sun_eq_of_center(Real t)
+{
+  Real m = calc_geom_mean_anomaly_sun(t);
+  return Const_math::sin_deg(m) * (Real(1.914602) - t * (Real(0.004817) + Real(0.000014) * t)) +
+         Const_math::sin_deg(2 * m) * (Real(0.019993) - Real(0.000101) * t) + Const_math::sin_deg(3 * m) * Real(0.000289);
+}
+
+/**
+ * @brief calculate equation of time
+ * @param t: Julian centuries
+ * @return Real equation of time in minutes
+ */
+template <typename Real>
+constexpr Real calc_equation_of_time(Real t)
+{
+  Real epsilon = calc_obliquity_correction(t);
+  Real l0 = calc_geom_mean_long_sun(t);
+  Real e = calc_eccentricity_earth_orbit(t);
+  Real m = calc_geom_mean_anomaly_sun(t);
+  Real y = Const_math::tan_deg(epsilon / 2);
+  y *= y;
+
+  Real sin2l0 = Const_math::sin_deg(2 * l0);
+  Real sinm = Const_math::sin_deg(m);
+  Real cos2l0 = Const_math::cos_deg(2 * l0);
+  Real sin4l0 = Const_math::sin_deg(4 * l0);
+  Real sin2m = Const_math::sin_deg(2 * m);
+  Real e_time = y * sin2l0 - 2 * e * sinm + 4 * e * y * sinm * cos2l0 - Real(0.5) * y * y * sin4l0 - Real(1.25) * e * e * sin2m;
+  return Const_math::rad_to_deg(e_time) * 4;
+}
+
+/**
+ * @brief calculate sun declination
+ * @param t: Julian centuries
+ * @return Real declination in degrees
+ */
+template <typename Real>
+constexpr Real calc_sun_declination(Real t)
+{
+  Real e = calc_obliquity_correction(t);
+  Real omega = Real(125.04) - Real(1934.136) * t;
+  Real lambda = calc_geom_mean_long_sun(t) + calc_sun_eq_of_center(t) - Real(0.00569) - Real(0.00478) * Const_math::sin_deg(omega);
+  return Const_math::rad_to_deg(Const_math::asin(Const_math::sin_deg(e) * Const_math::sin_deg(lambda)));
+}
+
+/**
+ * @brief calculate hour angle of sunrise, polar day and night are clamped
+ * @param latitude: latitude in degrees
+ * @param declination: sun declination in degrees
+ * @param zenith: sun zenith angle for event in degrees
+ * @return Real hour angle in degrees
+ */
+template <typename Real>
+constexpr Real calc_hour_angle_sunrise(Real latitude, Real declination, Real zenith)
+{
+  Real cos_ha = Const_math::cos_deg(zenith) / (Const_math::cos_deg(latitude) * Const_math::cos_deg(declination)) -
+                Const_math::tan_deg(latitude) * Const_math::tan_deg(declination);
+  if (cos_ha > 1)
+  {
+    cos_ha = 1;
+  }
+  else if (cos_ha < -1)
+  {
+    cos_ha = -1;
+  }
+  return Const_math::rad_to_deg(Const_math::acos(cos_ha));
+}
+
+/**
+ * @brief calculate UTC event time in two passes, same as SunSet::calcAbsSunrise/calcAbsSunset
+ * @param days: days from J2000.0 to midnight UTC
+ * @param latitude: latitude in degrees
+ * @param longitude: longitude in degrees
+ * @param zenith: sun zenith angle for event in degrees
+ * @param is_rising: true = sunrise; false = sunset
+ * @return Real time in minutes from 0:00 UTC
+ */
+template <typename Real>
+constexpr Real calc_abs_event(Real days, Real latitude, Real longitude, Real zenith, bool is_rising)
+{
+  Real time_utc = 720;
+  Real t = calc_time_julian_cent(days);
+  for (int pass = 0; pass < 2; pass++)
+  {
+    Real hour_angle = calc_hour_angle_sunrise(latitude, calc_sun_declination(t), zenith);
+    if (!is_rising)
+    {
+      hour_angle = -hour_angle;
+    }
+    time_utc = 720 - 4 * (longitude + hour_angle) - calc_equation_of_time(t);
+    t = calc_time_julian_cent(days + time_utc / min_in_day);
+  }
+  return time_utc;
+}
+
+/**
+ * @brief convert event time to local minutes from 0:00
+ * @param time_utc: UTC time in minutes
+ * @param tz_offset: timezone offset in hours
+ * @return uint16_t local time in minutes from 0:00
+ */
+template <typename Real>
+constexpr uint16_t to_local_minutes(Real time_utc, Real tz_offset)
+{
+  Real local = time_utc + 60 * tz_offset;
+  if (local < 0)
+  {
+    return 0;
+  }
+  if (local >= min_in_day)
+  {
+    return min_in_day - 1;
+  }
+  return static_cast<uint16_t>(local);
+}
+
+/**
+ * @brief calculate all events for one day
+ * @details Real is type of calculation, on AVR double has 32 bits so tables in flash are calculated as with float
+ * @param year: year
+ * @param month: month 1-12
+ * @param day: day of month 1-31
+ * @param latitude: latitude in degrees
+ * @param longitude: longitude in degrees
+ * @param tz_offset: timezone offset in hours
+ * @return Day_events events in local time
+ */
+template <typename Real = double>
+constexpr Day_events calc_day_events(int year, int month, int day, double latitude, double longitude, double tz_offset)
+{
+  Real days = calc_days_from_j2000<Real>(year, month, day);
+  Real lat = static_cast<Real>(latitude);
+  Real lon = static_cast<Real>(longitude);
+  Real tz = static_cast<Real>(tz_offset);
+  Day_events events{};
+  events.sunrise_civil = to_local_minutes(calc_abs_event(days, lat, lon, Real(civil_zenith), true), tz);
+  events.sunrise = to_local_minutes(calc_abs_event(days, lat, lon, Real(official_zenith), true), tz);
+  events.sunset = to_local_minutes(calc_abs_event(days, lat, lon, Real(official_zenith), false), tz);
+  events.sunset_civil = to_local_minutes(calc_abs_event(days, lat, lon, Real(civil_zenith), false), tz);
+  return events;
+}
+
+/**
+ * @brief day index in table, February always has 29 days
+ * @param month: month 1-12
+ * @param day: day of month 1-31
+ * @return uint16_t day index 0-365
+ */
+constexpr uint16_t day_of_year(uint8_t month, uint8_t day)
+{
+  const uint16_t days_before_month[12] = {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335};
+  return days_before_month[(month - 1) % 12] + day - 1;
+}
+
+/**
+ * @brief calculate table for whole year
+ * @details table of one leap year is used in every year: in common years entry of Feb 29 is skipped and other dates use entry
+ * of same month and day. Calendar date moves against sun by up to 3/4 day in 4 year cycle, so events in other years differ from
+ * SunSet by up to 2 minutes after truncation (table years in accuracy tool). avr-gcc calculates table with 32 bit double, float
+ * table differs from SunSet by up to 1 minute (float table in accuracy tool).
+ * @param year: reference leap year
+ * @param latitude: latitude in degrees
+ * @param longitude: longitude in degrees
+ * @param tz_offset: timezone offset in hours
+ * @return Year_table events for every day
+ */
+template <typename Real = double>
+constexpr Year_table make_year_table(int year, double latitude, double longitude, double tz_offset)
+{
+  const uint8_t month_length[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  Year_table table{};
+  uint16_t index = 0;
+  for (uint8_t month = 1; month <= 12; month++)
+  {
+    for (uint8_t day = 1; day <= month_length[month - 1]; day++)
+    {
+      table.days[index++] = calc_day_events<Real>(year, month, day, latitude, longitude, tz_offset);
+    }
+  }
+  return table;
+}
+
+/**
+ * @brief get events for date from table in flash, e.g. Location_table of clock
+ * @param table: table in flash made by make_year_table()
+ * @param month: month 1-12
+ * @param day: day of month 1-31
+ * @return Day_events events in local time of table
+ */
+Day_events get_day_events(const Year_table& table, uint8_t month, uint8_t day);
+} // namespace Ephemeris
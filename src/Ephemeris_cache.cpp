@@ -0,0 +1,84 @@
+/**
+ * @file Ephemeris_cache.cpp
+ * @brief Sun events of actual day kept in DS1307 battery backed RAM
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Ephemeris_cache.h"
+
+#include "Config.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static_assert(Config::ephemeris_cache_address + sizeof(Ephemeris_cache::Record) <= Ephemeris_cache::nvram_size,
+              "record must fit in RTC RAM");
+
+namespace
+{
+/**
+ * @brief CRC-8, polynomial 0x31 (Dallas/Maxim)
+ */
+uint8_t calculate_crc(const uint8_t* data, uint8_t size)
+{
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < size; i++)
+  {
+    crc ^= data[i];
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x31 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief record key for date and location, events and checksum are empty
+ */
+Ephemeris_cache::Record make_key(const DateTime& date, const Ephemeris::Location& location)
+{
+  Ephemeris_cache::Record record;
+  memset(&record, 0, sizeof(record));
+  record.version = Ephemeris_cache::version;
+  record.year = date.year();
+  record.month = date.month();
+  record.day = date.day();
+  record.latitude = static_cast<int32_t>(location.latitude * 100000);
+  record.longitude = static_cast<int32_t>(location.longitude * 100000);
+  record.tz_offset = location.tz_offset;
+  return record;
+}
+} // namespace
+
+bool Ephemeris_cache::load(
+    RTC_DS1307& rtc, uint8_t address, const DateTime& date, const Ephemeris::Location& location, Ephemeris::Day_events& events)
+{
+  Record stored;
+  rtc.readnvram(reinterpret_cast<uint8_t*>(&stored), sizeof(stored), address);
+  if (stored.checksum != calculate_crc(reinterpret_cast<const uint8_t*>(&stored), offsetof(Record, checksum)))
+  {
+    return false;
+  }
+
+  Record key = make_key(date, location);
+  key.events = stored.events;
+  key.checksum = stored.checksum;
+  if (memcmp(&key, &stored, sizeof(Record)) != 0)
+  {
+    return false;
+  }
+  events = stored.events;
+  return true;
+}
+
+void Ephemeris_cache::save(
+    RTC_DS1307& rtc, uint8_t address, const DateTime& date, const Ephemeris::Location& location, const Ephemeris::Day_events& events)
+{
+  Record record = make_key(date, location);
+  record.events = events;
+  record.checksum = calculate_crc(reinterpret_cast<const uint8_t*>(&record), offsetof(Record, checksum));
+  rtc.writenvram(address, reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+}
@@ -0,0 +1,58 @@
+/**
+ * @file Ephemeris_cache.h
+ * @brief Sun events of actual day kept in DS1307 battery backed RAM
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Ephemeris.h"
+#include "RTClib.h"
+
+#include <stdint.h>
+
+namespace Ephemeris_cache
+{
+const uint8_t version = 1; ///< record layout version, change when record changes
+const uint8_t nvram_size = 56; ///< DS1307 RAM size
+
+///< cached events with key
+struct Record
+{
+  uint8_t version; ///< record layout version
+  uint16_t year; ///< date of events
+  uint8_t month;
+  uint8_t day;
+  int32_t latitude; ///< location in 1e-5 degree
+  int32_t longitude;
+  int8_t tz_offset; ///< timezone offset in hours
+  Ephemeris::Day_events events; ///< events in local time
+  uint8_t checksum; ///< CRC-8 of all bytes before
+};
+
+static_assert(sizeof(Record) <= 30, "record must fit in one I2C transfer");
+
+/**
+ * @brief read events from RTC RAM
+ * @param rtc: DS1307
+ * @param address: record address in RTC RAM
+ * @param date: day of events
+ * @param location: location and timezone of events
+ * @param events: events, changed only when record is valid
+ * @return true record has same date, location and timezone and valid checksum
+ * @return false events have to be calculated
+ */
+bool load(RTC_DS1307& rtc, uint8_t address, const DateTime& date, const Ephemeris::Location& location, Ephemeris::Day_events& events);
+
+/**
+ * @brief write events to RTC RAM
+ * @param rtc: DS1307
+ * @param address: record address in RTC RAM
+ * @param date: day of events
+ * @param location: location and timezone of events
+ * @param events: events in local time
+ */
+void save(RTC_DS1307& rtc, uint8_t address, const DateTime& date, const Ephemeris::Location& location, const Ephemeris::Day_events& events);
+} // namespace Ephemeris_cache
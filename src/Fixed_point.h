@@ -0,0 +1,87 @@
+/**
+ * @file Fixed_point.h
+ * @brief Integer interpolation for colors
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace Fixed_point
+{
+const uint8_t q15_shift = 15; ///< fraction bits
+const uint16_t q15_one = 1U << q15_shift; ///< 1.0 in Q15
+
+const uint32_t max_exact_span = 0xFFFFFF; ///< longer spans are scaled down, span * 255 has to fit in 32 bits
+
+///< position between two points in time
+struct Progress
+{
+  uint32_t elapsed; ///< time from start
+  uint32_t span; ///< time from start to end, up to max_exact_span
+  uint16_t fraction; ///< elapsed / span in Q15
+};
+
+/**
+ * @brief calculate progress between two points in time, only one division
+ * @details spans over max_exact_span (4.6 h in ms) are scaled down, fraction is calculated from 16 bit part of values
+ * @param now: actual time
+ * @param start: start time, now >= start
+ * @param end: end time, end >= now
+ * @return Progress progress from start to end
+ */
+inline Progress make_progress(uint32_t now, uint32_t start, uint32_t end)
+{
+  uint32_t elapsed = now - start;
+  uint32_t span = end - start;
+  while (span > max_exact_span)
+  {
+    span >>= 1;
+    elapsed >>= 1;
+  }
+
+  Progress progress;
+  progress.span = span;
+  if (span == 0 || elapsed >= span)
+  {
+    progress.elapsed = span;
+    progress.fraction = q15_one;
+    return progress;
+  }
+  progress.elapsed = elapsed;
+  while (span > 0xFFFF)
+  {
+    span >>= 1;
+    elapsed >>= 1;
+  }
+  progress.fraction = (elapsed << q15_shift) / span;
+  return progress;
+}
+
+/**
+ * @brief linear interpolation, same result as map(elapsed, 0, span, from, to) without division
+ * @param from: value on start
+ * @param to: value on end
+ * @param progress: progress from start to end
+ * @return uint8_t interpolated value
+ */
+inline uint8_t lerp(uint8_t from, uint8_t to, const Progress& progress)
+{
+  uint8_t delta = (to > from) ? to - from : from - to;
+  uint16_t step = (static_cast<uint32_t>(delta) * progress.fraction) >> q15_shift;
+  // fraction of 16 bit values is off by one step at most, exact step of map() is checked with multiplications
+  uint32_t target = progress.elapsed * delta;
+  if ((step + 1) * progress.span <= target)
+  {
+    step++;
+  }
+  else if (step * progress.span > target)
+  {
+    step--;
+  }
+  return (to > from) ? from + step : from - step;
+}
+} // namespace Fixed_point
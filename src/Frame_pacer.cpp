@@ -0,0 +1,79 @@
+/**
+ * @file Frame_pacer.cpp
+ * @brief Animation frame timing and CPU time measurement
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Frame_pacer.h"
+
+#include "Log.h"
+
+#include <Arduino.h>
+
+Frame_pacer::Frame_pacer(uint16_t frame_time_ms, uint16_t budget_us)
+: m_frame_time_ms(frame_time_ms)
+, m_budget_us(budget_us)
+, m_last_frame_ms(0)
+, m_frame_start_us(0)
+{
+  reset_stats();
+}
+
+bool Frame_pacer::is_frame_due(unsigned long now_ms)
+{
+  if (now_ms - m_last_frame_ms < m_frame_time_ms)
+  {
+    return false;
+  }
+  m_last_frame_ms = now_ms;
+  return true;
+}
+
+void Frame_pacer::begin_frame()
+{
+  m_frame_start_us = micros();
+}
+
+void Frame_pacer::end_frame()
+{
+  unsigned long duration = micros() - m_frame_start_us;
+  if (duration > 0xFFFF)
+  {
+    duration = 0xFFFF;
+  }
+  m_total_us += duration;
+  if (duration > m_max_us)
+  {
+    m_max_us = duration;
+  }
+  if (duration > m_budget_us)
+  {
+    m_over_budget++;
+  }
+  if (m_frames < 0xFFFF)
+  {
+    m_frames++;
+  }
+}
+
+void Frame_pacer::print_stats() const
+{
+  Log::out.print(F("frames: "));
+  Log::out.print(m_frames);
+  Log::out.print(F(" avg us: "));
+  Log::out.print(m_frames ? m_total_us / m_frames : 0);
+  Log::out.print(F(" max us: "));
+  Log::out.print(m_max_us);
+  Log::out.print(F(" over budget: "));
+  Log::out.println(m_over_budget);
+}
+
+void Frame_pacer::reset_stats()
+{
+  m_total_us = 0;
+  m_max_us = 0;
+  m_frames = 0;
+  m_over_budget = 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file Frame_pacer.h
+ * @brief Animation frame timing and CPU time measurement
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+class Frame_pacer
+{
+public:
+  /**
+   * @brief Construct a new Frame_pacer
+   * @param frame_time_ms: time between frames
+   * @param budget_us: maximum CPU time for one frame
+   */
+  Frame_pacer(uint16_t frame_time_ms, uint16_t budget_us);
+
+  /**
+   * @brief check if next frame should be rendered, late frames are not caught up
+   * @param now_ms: actual Timebase::get_time_ms(), SQW seconds with ms from millis(), so frames follow RTC time
+   * @return true render frame now
+   * @return false wait
+   */
+  bool is_frame_due(unsigned long now_ms);
+
+  /**
+   * @brief start measuring frame CPU time
+   */
+  void begin_frame();
+
+  /**
+   * @brief stop measuring frame CPU time
+   */
+  void end_frame();
+
+  /**
+   * @brief print frames count, average and maximum frame time and budget overruns on log
+   */
+  void print_stats() const;
+
+  /**
+   * @brief clear statistics
+   */
+  void reset_stats();
+
+private:
+  const uint16_t m_frame_time_ms; ///< time between frames
+  const uint16_t m_budget_us; ///< maximum CPU time for one frame
+  unsigned long m_last_frame_ms; ///< start of last frame
+  unsigned long m_frame_start_us; ///< micros() on begin_frame()
+  uint32_t m_total_us; ///< sum of frame times
+  uint16_t m_max_us; ///< longest frame
+  uint16_t m_frames; ///< measured frames
+  uint16_t m_over_budget; ///< frames longer than budget
+};
@@ -0,0 +1,105 @@
+/**
+ * @file Log.cpp
+ * @brief Logging with compile-time levels and non-blocking output
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Log.h"
+
+namespace Log
+{
+static_assert((buffer_size & (buffer_size - 1)) == 0, "buffer_size must be power of two");
+static_assert(line_size < buffer_size, "line_size must fit into buffer");
+
+const uint8_t m_index_mask = buffer_size - 1;
+
+Buffer out;
+
+size_t Buffer::write(uint8_t value)
+{
+  if (!m_is_dropping)
+  {
+    uint8_t next = (m_write + 1) & m_index_mask;
+    if (next == m_read)
+    {
+      flush();
+    }
+    if (next == m_read)
+    {
+      // no space, drop what was already written from this line
+      m_write = m_ready;
+      m_is_dropping = true;
+      m_dropped++;
+    }
+    else
+    {
+      m_data[m_write] = value;
+      m_write = next;
+    }
+  }
+
+  if (value == '\n')
+  {
+    if (m_is_dropping)
+    {
+      m_is_dropping = false;
+      return 0;
+    }
+    m_ready = m_write;
+  }
+  return m_is_dropping ? 0 : 1;
+}
+
+void Buffer::flush()
+{
+  int space = Serial.availableForWrite();
+  while (space > 0 && m_read != m_ready)
+  {
+    Serial.write(m_data[m_read]);
+    m_is_written = true;
+    m_read = (m_read + 1) & m_index_mask;
+    space--;
+  }
+}
+
+bool Buffer::has_space(uint8_t size)
+{
+  flush();
+  uint8_t free = (m_read - m_write - 1) & m_index_mask;
+  return free >= size;
+}
+
+void Buffer::report_dropped()
+{
+  // "log dropped: 65535\r\n"
+  const uint8_t report_size = 20;
+  if (m_dropped == m_reported || !has_space(report_size))
+  {
+    return;
+  }
+  m_reported = m_dropped;
+  print(F("log dropped: "));
+  println(m_dropped);
+}
+
+bool Buffer::is_sent() const
+{
+  if (m_read != m_write || Serial.availableForWrite() < SERIAL_TX_BUFFER_SIZE - 1)
+  {
+    return false;
+  }
+#ifdef __AVR__
+  // TX buffer is empty while last bytes are in UDR0 and shift register, HardwareSerial::write() clears TXC0
+  return !m_is_written || bit_is_set(UCSR0A, TXC0);
+#else
+  return true;
+#endif
+}
+
+uint16_t Buffer::get_dropped() const
+{
+  return m_dropped;
+}
+} // namespace Log
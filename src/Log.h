@@ -0,0 +1,83 @@
+/**
+ * @file Log.h
+ * @brief Logging with compile-time levels and non-blocking output
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifndef SUN_CLOCK_LOG_LEVEL
+#define SUN_CLOCK_LOG_LEVEL 2 ///< 0 none, 1 error, 2 info, 3 debug
+#endif
+
+namespace Log
+{
+constexpr bool is_error = SUN_CLOCK_LOG_LEVEL >= 1; ///< errors are compiled in
+constexpr bool is_info = SUN_CLOCK_LOG_LEVEL >= 2; ///< sync time, sun events and stats are compiled in
+constexpr bool is_debug = SUN_CLOCK_LOG_LEVEL >= 3; ///< colors and servo moves are compiled in
+
+const uint8_t buffer_size = 128; ///< bytes waiting for Serial, power of two
+const uint8_t line_size = 120; ///< longest stats line, bursts of lines wait with has_space() for free space instead of being dropped
+
+///< ring buffer in front of Serial, whole lines are dropped when there is no space
+class Buffer : public Print
+{
+public:
+  /**
+   * @brief add byte to actual line, line is ready to send after '\n'
+   * @param value: byte
+   * @return size_t 1 = stored; 0 = line dropped
+   */
+  size_t write(uint8_t value) override;
+
+  using Print::write;
+
+  /**
+   * @brief move ready lines to Serial TX buffer, only as many bytes as it can take without waiting
+   */
+  void flush();
+
+  /**
+   * @brief check if line fits into buffer now, ready lines are moved to Serial first
+   * @param size: bytes of line with "\r\n"
+   * @return true line can be printed without drop
+   * @return false caller should try again in next loop pass
+   */
+  bool has_space(uint8_t size);
+
+  /**
+   * @brief print number of dropped lines as error when it changed since last report and report fits into buffer
+   */
+  void report_dropped();
+
+  /**
+   * @brief check if all bytes left MCU, UART stops in power down
+   * @return true buffer and Serial TX buffer are empty, on AVR last byte left shift register too (TXC0)
+   * @return false sending
+   */
+  bool is_sent() const;
+
+  /**
+   * @brief get number of dropped lines
+   * @return uint16_t dropped lines from start
+   */
+  uint16_t get_dropped() const;
+
+private:
+  uint8_t m_data[buffer_size]; ///< bytes
+  uint8_t m_read = 0; ///< next byte to send
+  uint8_t m_ready = 0; ///< end of complete lines
+  uint8_t m_write = 0; ///< end of actual line
+  bool m_is_dropping = false; ///< actual line did not fit
+  bool m_is_written = false; ///< some byte was moved to Serial, TXC0 is valid
+  uint16_t m_dropped = 0; ///< dropped lines
+  uint16_t m_reported = 0; ///< dropped lines in last report_dropped()
+};
+
+extern Buffer out; ///< log output, use inside if constexpr (Log::is_...) so disabled logs are removed
+} // namespace Log
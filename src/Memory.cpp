@@ -0,0 +1,96 @@
+/**
+ * @file Memory.cpp
+ * @brief SRAM usage, free RAM and stack high-water mark from painted stack
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Memory.h"
+
+#include "Log.h"
+
+#include <Arduino.h>
+
+#ifdef __AVR__
+extern uint8_t _end; ///< end of .data and .bss, start of heap
+extern uint8_t __stack; ///< top of RAM
+extern char* __brkval; ///< end of heap, 0 before first malloc()
+
+/**
+ * @brief fill RAM from end of static data to top of stack, runs in .init3 before constructors and main()
+ * @details naked and without calls, stack is not used yet
+ */
+void paint_stack() __attribute__((naked, used, section(".init3")));
+
+void paint_stack()
+{
+  uint8_t* address = &_end;
+  while (address <= &__stack)
+  {
+    *address++ = Memory::paint;
+  }
+}
+
+namespace
+{
+/**
+ * @brief first byte over heap
+ */
+uint8_t* get_heap_end()
+{
+  return __brkval ? reinterpret_cast<uint8_t*>(__brkval) : &_end;
+}
+
+/**
+ * @brief lowest byte written by stack, scan from heap up to first overwritten byte
+ */
+uint8_t* get_stack_bottom()
+{
+  uint8_t* address = get_heap_end();
+  while (address <= &__stack && *address == Memory::paint)
+  {
+    address++;
+  }
+  return address;
+}
+} // namespace
+#endif
+
+uint16_t Memory::get_free_ram()
+{
+#ifdef __AVR__
+  uint8_t top;
+  return &top - get_heap_end();
+#else
+  return 0;
+#endif
+}
+
+uint16_t Memory::get_stack_high_water()
+{
+#ifdef __AVR__
+  return &__stack - get_stack_bottom() + 1;
+#else
+  return 0;
+#endif
+}
+
+uint16_t Memory::get_min_free_ram()
+{
+#ifdef __AVR__
+  return get_stack_bottom() - get_heap_end();
+#else
+  return 0;
+#endif
+}
+
+void Memory::print_stats()
+{
+  Log::out.print(F("free ram: "));
+  Log::out.print(get_free_ram());
+  Log::out.print(F(" stack max: "));
+  Log::out.print(get_stack_high_water());
+  Log::out.print(F(" min free: "));
+  Log::out.println(get_min_free_ram());
+}
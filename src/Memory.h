@@ -0,0 +1,39 @@
+/**
+ * @file Memory.h
+ * @brief SRAM usage, free RAM and stack high-water mark from painted stack
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace Memory
+{
+const uint8_t paint = 0xC5; ///< value written to free RAM before constructors run
+
+/**
+ * @brief get RAM between heap and actual stack pointer
+ * @return uint16_t free bytes, 0 on host
+ */
+uint16_t get_free_ram();
+
+/**
+ * @brief get deepest stack from reset, found as lowest byte of painted RAM which was overwritten
+ * @return uint16_t stack bytes, 0 on host
+ */
+uint16_t get_stack_high_water();
+
+/**
+ * @brief get smallest gap between heap and stack from reset
+ * @return uint16_t bytes which were never used, 0 on host
+ */
+uint16_t get_min_free_ram();
+
+/**
+ * @brief print free RAM, stack high-water mark and smallest gap on log
+ */
+void print_stats();
+} // namespace Memory
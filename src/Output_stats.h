@@ -0,0 +1,42 @@
+/**
+ * @file Output_stats.h
+ * @brief Counters of committed and skipped output updates
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+///< updates sent to hardware and updates skipped because value did not change
+struct Update_counter
+{
+  uint32_t committed;
+  uint32_t skipped;
+
+  /**
+   * @brief count one update
+   * @param is_committed: true = sent to hardware; false = skipped
+   */
+  void count(bool is_committed)
+  {
+    if (is_committed)
+    {
+      committed++;
+    }
+    else
+    {
+      skipped++;
+    }
+  }
+};
+
+///< counters for every output
+struct Output_stats
+{
+  Update_counter sun; ///< sun PWM channels
+  Update_counter sky; ///< sky strip show()
+  Update_counter servo; ///< servo moves
+};
@@ -0,0 +1,198 @@
+/**
+ * @file Power.cpp
+ * @brief MCU sleep between output changes
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Power.h"
+
+#include "Log.h"
+#include "Timebase.h"
+
+#include <Arduino.h>
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#endif
+
+namespace
+{
+///< watchdog period and its WDTO_ value
+struct Watchdog_period
+{
+  uint16_t time_ms;
+  uint8_t wdto;
+};
+
+const Watchdog_period m_periods[] = {
+    {8000, 9}, {4000, 8}, {2000, 7}, {1000, 6}, {500, 5}, {250, 4}, {120, 3}, {60, 2}, {30, 1}, {15, 0}};
+
+const uint8_t m_pin_serial_rx = 0; ///< UART RX, its edge wakes MCU from power down
+
+uint32_t m_power_down_ms = 0; ///< time in power down from last reset_stats()
+uint16_t m_power_downs = 0; ///< power downs from last reset_stats()
+uint32_t m_idles = 0; ///< idle sleeps from last reset_stats()
+uint32_t m_idle_us = 0; ///< time in idle from last reset_stats()
+uint32_t m_period_start_ms = 0; ///< Timebase::get_time_ms() on last reset_stats()
+uint16_t m_sqw_wakes = 0; ///< wakes by rising SQW edge from last reset_stats(), MCU slept again without main loop
+volatile bool m_is_watchdog_expired = false; ///< watchdog interrupt came in actual power down
+
+#ifdef __AVR__
+/**
+ * @brief start watchdog in interrupt mode, without reset
+ */
+void start_watchdog(uint8_t wdto)
+{
+  uint8_t prescaler = (wdto & 0x07) | ((wdto & 0x08) ? _BV(WDP3) : 0);
+  cli();
+  MCUSR &= ~_BV(WDRF);
+  WDTCSR = _BV(WDCE) | _BV(WDE);
+  WDTCSR = _BV(WDIE) | prescaler;
+  sei();
+}
+#else
+unsigned long m_idle_start_us = 0; ///< micros() when idle() was called
+bool m_is_idle = false; ///< idle() was called and no other call of Power came after it
+
+/**
+ * @brief end idle on host, simulated time moves only between loop() calls, so idle lasts until next call of Power
+ */
+void end_idle()
+{
+  if (m_is_idle)
+  {
+    m_idle_us += micros() - m_idle_start_us;
+    m_is_idle = false;
+  }
+}
+#endif
+
+/**
+ * @brief print part of period in percent with one decimal
+ */
+void print_percent(uint32_t part_ms, uint32_t period_ms)
+{
+  // stats period is 30 s, so product fits in 32 bits without 64 bit division on AVR
+  uint16_t permille = period_ms ? static_cast<uint16_t>((part_ms * 1000UL + period_ms / 2) / period_ms) : 0;
+  Log::out.print(permille / 10);
+  Log::out.print('.');
+  Log::out.print(permille % 10);
+}
+} // namespace
+
+#ifdef __AVR__
+ISR(WDT_vect)
+{
+  m_is_watchdog_expired = true;
+}
+#endif
+
+void Power::idle()
+{
+  m_idles++;
+#ifdef __AVR__
+  // micros() keeps counting in idle, timer 0 wakes at least every 1 ms
+  unsigned long start_us = micros();
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  sleep_enable();
+  sleep_cpu();
+  sleep_disable();
+  m_idle_us += micros() - start_us;
+#else
+  end_idle();
+  m_idle_start_us = micros();
+  m_is_idle = true;
+#endif
+}
+
+void Power::power_down(uint32_t time_ms)
+{
+#ifndef __AVR__
+  end_idle();
+#endif
+  uint32_t start_ms = Timebase::get_time_ms();
+  const Watchdog_period* period = &m_periods[sizeof(m_periods) / sizeof(m_periods[0]) - 1];
+  for (const auto& candidate : m_periods)
+  {
+    if (candidate.time_ms <= time_ms)
+    {
+      period = &candidate;
+      break;
+    }
+  }
+
+#ifdef __AVR__
+  // first byte is lost, but MCU stays awake for next ones
+  *digitalPinToPCMSK(m_pin_serial_rx) |= _BV(digitalPinToPCMSKbit(m_pin_serial_rx));
+  *digitalPinToPCICR(m_pin_serial_rx) |= _BV(digitalPinToPCICRbit(m_pin_serial_rx));
+  m_is_watchdog_expired = false;
+  start_watchdog(period->wdto);
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  uint8_t wakes = 0;
+  cli();
+  Timebase::clear_wake();
+  // pin change comes on both SQW edges, rising one only wakes MCU for oscillator start and ISR, then it sleeps again
+  while (!m_is_watchdog_expired && !Timebase::is_wake_needed())
+  {
+    sleep_enable();
+    sleep_bod_disable();
+    sei(); // sleep_cpu() runs before any interrupt
+    sleep_cpu();
+    sleep_disable();
+    cli();
+    wakes++;
+  }
+  sei();
+  wdt_disable();
+  m_sqw_wakes += wakes ? wakes - 1 : 0;
+  *digitalPinToPCMSK(m_pin_serial_rx) &= ~_BV(digitalPinToPCMSKbit(m_pin_serial_rx));
+#else
+  delay(period->time_ms);
+#endif
+
+  // millis() stops in power down, SQW seconds keep counting
+  m_power_down_ms += Timebase::get_time_ms() - start_ms;
+  m_power_downs++;
+}
+
+void Power::print_stats()
+{
+#ifndef __AVR__
+  end_idle();
+#endif
+  Log::out.print(F("power down ms: "));
+  Log::out.print(m_power_down_ms);
+  Log::out.print(F(" power downs: "));
+  Log::out.print(m_power_downs);
+  Log::out.print(F(" idles: "));
+  Log::out.print(m_idles);
+  Log::out.print(F(" sqw wakes: "));
+  Log::out.print(m_sqw_wakes);
+
+  // power down time comes from SQW seconds, so shares are accurate to few ms
+  uint32_t period_ms = Timebase::get_time_ms() - m_period_start_ms;
+  uint32_t idle_ms = m_idle_us / 1000;
+  uint32_t sleep_ms = idle_ms + m_power_down_ms;
+  uint32_t active_ms = (period_ms > sleep_ms) ? period_ms - sleep_ms : 0;
+  Log::out.print(F(" active/idle/down %: "));
+  print_percent(active_ms, period_ms);
+  Log::out.print('/');
+  print_percent(idle_ms, period_ms);
+  Log::out.print('/');
+  print_percent(m_power_down_ms, period_ms);
+  Log::out.println();
+}
+
+void Power::reset_stats()
+{
+  m_power_down_ms = 0;
+  m_power_downs = 0;
+  m_idles = 0;
+  m_idle_us = 0;
+  m_period_start_ms = Timebase::get_time_ms();
+  m_sqw_wakes = 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file Power.h
+ * @brief MCU sleep between output changes
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace Power
+{
+const uint16_t min_power_down_ms = 15; ///< shortest watchdog period
+const uint16_t max_power_down_ms = 8000; ///< longest watchdog period
+
+/**
+ * @brief stop CPU until next interrupt (timer 0 tick at most 1 ms), timers, PWM and UART keep running
+ */
+void idle();
+
+/**
+ * @brief stop everything except watchdog and pin change interrupts, PWM outputs and UART stop too
+ * @details sleeps for longest watchdog period not longer than time, at least min_power_down_ms, falling RTC SQW or serial RX edge wakes
+ * earlier. Rising SQW edge wakes MCU too (pin change interrupt has no edge select), it is counted and MCU sleeps again.
+ * @param time_ms: time to next work
+ */
+void power_down(uint32_t time_ms);
+
+/**
+ * @brief print time in power down, number of sleeps, wakes by rising SQW edge and active, idle and power down time as percent of
+ * time from reset_stats() on log
+ */
+void print_stats();
+
+/**
+ * @brief clear statistics, time from get_time_ms() is not changed
+ */
+void reset_stats();
+} // namespace Power
@@ -0,0 +1,172 @@
+/**
+ * @file Profiler.cpp
+ * @brief Latency histograms of loop stages, compiled only with SUN_CLOCK_PROFILE
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Profiler.h"
+
+#ifdef SUN_CLOCK_PROFILE
+
+#include "Config.h"
+#include "Log.h"
+
+namespace Profiler
+{
+namespace
+{
+const uint8_t m_stage_count = static_cast<uint8_t>(Stage::count);
+
+///< time statistics of one stage
+struct Stage_stats
+{
+  uint16_t buckets[bucket_count]; ///< saturated counters
+  uint16_t max_us; ///< longest time, saturated
+  uint16_t misses; ///< times over deadline
+};
+
+Stage_stats m_stats[m_stage_count]; ///< statistics from last print
+uint8_t m_print_line = 0; ///< next line of histograms
+bool m_is_printing = false; ///< request came, lines are printed
+
+/**
+ * @brief bucket of time, number of significant bits
+ */
+uint8_t get_bucket(unsigned long duration_us)
+{
+  uint8_t bucket = 0;
+  while (duration_us && bucket < bucket_count - 1)
+  {
+    duration_us >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+/**
+ * @brief deadline of stage, 0 = no deadline
+ */
+unsigned long get_deadline_us(Stage stage)
+{
+  switch (stage)
+  {
+    case Stage::frame:
+      return Config::frame_budget_us;
+    case Stage::dither:
+      return Config::dither_budget_us;
+    case Stage::loop:
+      return Config::loop_deadline_us;
+    default:
+      return 0;
+  }
+}
+
+void print_name(Stage stage)
+{
+  switch (stage)
+  {
+    case Stage::rtc:
+      Log::out.print(F("rtc"));
+      break;
+    case Stage::ephemeris:
+      Log::out.print(F("ephemeris"));
+      break;
+    case Stage::servo:
+      Log::out.print(F("servo"));
+      break;
+    case Stage::sun_pwm:
+      Log::out.print(F("sun pwm"));
+      break;
+    case Stage::sky_render:
+      Log::out.print(F("sky render"));
+      break;
+    case Stage::sky_show:
+      Log::out.print(F("sky show"));
+      break;
+    case Stage::frame:
+      Log::out.print(F("frame"));
+      break;
+    case Stage::dither:
+      Log::out.print(F("dither"));
+      break;
+    default:
+      Log::out.print(F("loop"));
+      break;
+  }
+}
+
+/**
+ * @brief print max and deadline misses or histogram of one stage
+ */
+void print_line(uint8_t line)
+{
+  uint8_t stage = line / 2;
+  const Stage_stats& stats = m_stats[stage];
+  print_name(static_cast<Stage>(stage));
+  if (line % 2 == 0)
+  {
+    Log::out.print(F(" max us: "));
+    Log::out.print(stats.max_us);
+    Log::out.print(F(" miss: "));
+    Log::out.println(stats.misses);
+    return;
+  }
+  Log::out.print(F(" hist:"));
+  for (auto count : stats.buckets)
+  {
+    Log::out.print(' ');
+    Log::out.print(count);
+  }
+  Log::out.println();
+}
+} // namespace
+
+void record(Stage stage, unsigned long duration_us)
+{
+  Stage_stats& stats = m_stats[static_cast<uint8_t>(stage)];
+  uint16_t& count = stats.buckets[get_bucket(duration_us)];
+  if (count < 0xFFFF)
+  {
+    count++;
+  }
+  uint16_t duration = (duration_us > 0xFFFF) ? 0xFFFF : duration_us;
+  if (duration > stats.max_us)
+  {
+    stats.max_us = duration;
+  }
+  unsigned long deadline = get_deadline_us(stage);
+  if (deadline && duration_us > deadline && stats.misses < 0xFFFF)
+  {
+    stats.misses++;
+  }
+}
+
+void request_print()
+{
+  m_is_printing = true;
+}
+
+void update()
+{
+  // one line at a time, so histograms never overflow log buffer
+  if (!m_is_printing || !Log::out.is_sent())
+  {
+    return;
+  }
+  if (m_print_line == 0)
+  {
+    Log::out.println(F("latency us buckets: <1 <2 <4 .. <16384 >=16384"));
+  }
+  print_line(m_print_line++);
+  if (m_print_line == m_stage_count * 2)
+  {
+    memset(m_stats, 0, sizeof(m_stats));
+    m_print_line = 0;
+    m_is_printing = false;
+  }
+}
+} // namespace Profiler
+
+#endif
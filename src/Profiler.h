@@ -0,0 +1,99 @@
+/**
+ * @file Profiler.h
+ * @brief Latency histograms of loop stages, compiled only with SUN_CLOCK_PROFILE
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+namespace Profiler
+{
+#ifdef SUN_CLOCK_PROFILE
+constexpr bool is_enabled = true; ///< stages are measured
+#else
+constexpr bool is_enabled = false; ///< release, all measurement is removed by compiler
+#endif
+
+///< measured part of loop()
+enum class Stage : uint8_t
+{
+  rtc, ///< RTC read over I2C
+  ephemeris, ///< sun events and keyframes of new day
+  servo, ///< servo move and turn off
+  sun_pwm, ///< sun PWM writes
+  sky_render, ///< sky gradient to strip buffer
+  sky_show, ///< strip transmission
+  frame, ///< whole render_frame()
+  dither, ///< sun and sky refresh with next dither pattern
+  loop, ///< whole loop() without sleep
+  count
+};
+
+const uint8_t bucket_count = 16; ///< bucket 0 counts 0 us, bucket i from 2^(i-1) to 2^i - 1 us, last one also longer times
+
+/**
+ * @brief add stage time to histogram, frame and loop are also checked against deadline
+ * @param stage: measured stage
+ * @param duration_us: stage time
+ */
+void record(Stage stage, unsigned long duration_us);
+
+/**
+ * @brief start printing histograms in next update() calls
+ */
+void request_print();
+
+/**
+ * @brief print one line of requested histograms in each call when log is sent
+ * @details statistics are cleared after last line
+ */
+void update();
+
+///< measure time from construction to end() or end of scope
+class Scope
+{
+public:
+  /**
+   * @brief Construct a new Scope and start measuring
+   * @param stage: measured stage
+   */
+  explicit Scope(Stage stage)
+  : m_stage(stage)
+  {
+    if constexpr (is_enabled)
+    {
+      m_start_us = micros();
+    }
+  }
+
+  ~Scope()
+  {
+    end();
+  }
+
+  /**
+   * @brief stop measuring before end of scope, next calls are ignored
+   */
+  void end()
+  {
+    if constexpr (is_enabled)
+    {
+      if (!m_is_ended)
+      {
+        record(m_stage, micros() - m_start_us);
+        m_is_ended = true;
+      }
+    }
+  }
+
+private:
+  Stage m_stage; ///< measured stage
+  unsigned long m_start_us = 0; ///< micros() on start
+  bool m_is_ended = false; ///< time is recorded
+};
+} // namespace Profiler
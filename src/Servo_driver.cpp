@@ -0,0 +1,144 @@
+/**
+ * @file Servo_driver.cpp
+ * @brief Non-blocking servo driver, smooth move in us steps with speed and acceleration limits, detach after move
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Servo_driver.h"
+
+#include <Arduino.h>
+
+namespace
+{
+/**
+ * @brief limit in us per s (or s^2) to 1/16 us per step (or step^2), at least 1
+ */
+int16_t per_step(uint32_t value, uint8_t steps)
+{
+  uint32_t result = (value << Servo_driver::fraction_bits);
+  for (uint8_t i = 0; i < steps; i++)
+  {
+    result = result * Servo_driver::step_ms / 1000;
+  }
+  return (result > 0) ? result : 1;
+}
+} // namespace
+
+Servo_driver::Servo_driver(uint8_t pin, uint16_t move_time_ms, const Servo_limits& limits)
+: m_pin(pin)
+, m_move_time_ms(move_time_ms)
+, m_min_pulse(limits.min_pulse_us << fraction_bits)
+, m_pulse_range_us(limits.max_pulse_us - limits.min_pulse_us)
+, m_max_velocity(per_step(limits.max_speed, 1))
+, m_acceleration(per_step(limits.max_acceleration, 2))
+, m_braking_factor(2 * m_acceleration)
+, m_min_step((limits.min_step_us > 0) ? (limits.min_step_us << fraction_bits) : 1)
+, m_state(State::idle)
+, m_position(m_no_position)
+, m_target(m_no_position)
+, m_velocity(0)
+, m_step_ms(0)
+{}
+
+bool Servo_driver::move(uint16_t position)
+{
+  // one division per target, steps use only add, multiply and compare
+  uint16_t target = m_min_pulse + static_cast<uint32_t>(position) * m_pulse_range_us / max_angle;
+  if (m_position == m_no_position)
+  {
+    m_target = target;
+    // position is not known after start, slow move is not possible
+    m_position = target;
+    write_pulse();
+    m_servo.attach(m_pin);
+    m_state = State::settling;
+    m_step_ms = millis();
+    return true;
+  }
+  // change of 1/16 degree would turn servo on for time_for_servo_move only to stay on the same pulse
+  uint16_t change = (target > m_target) ? target - m_target : m_target - target;
+  if (change < m_min_step)
+  {
+    return false;
+  }
+  m_target = target;
+
+  if (m_state == State::idle)
+  {
+    // pulse is set before attach, first pulse is not default 1500 us
+    write_pulse();
+    m_servo.attach(m_pin);
+    m_step_ms = millis();
+  }
+  m_state = State::moving;
+  return true;
+}
+
+void Servo_driver::update()
+{
+  if (m_state == State::idle)
+  {
+    return;
+  }
+  unsigned long now = millis();
+  if (m_state == State::settling)
+  {
+    if (now - m_step_ms >= m_move_time_ms)
+    {
+      m_servo.detach();
+      m_state = State::idle;
+    }
+    return;
+  }
+  if (now - m_step_ms < step_ms)
+  {
+    return;
+  }
+  m_step_ms = now;
+  if (step())
+  {
+    m_state = State::settling;
+  }
+  write_pulse();
+}
+
+bool Servo_driver::is_moving() const
+{
+  return m_state != State::idle;
+}
+
+bool Servo_driver::step()
+{
+  int32_t distance = static_cast<int32_t>(m_target) - m_position;
+  int16_t speed = (m_velocity < 0) ? -m_velocity : m_velocity;
+  int32_t remaining = (distance < 0) ? -distance : distance;
+  if (remaining <= m_acceleration && speed <= m_acceleration)
+  {
+    m_position = m_target;
+    m_velocity = 0;
+    return true;
+  }
+
+  // distance needed to stop from actual speed is v^2 / 2a, compared as remaining * 2a > v^2 without division
+  int32_t speed_square = static_cast<int32_t>(speed) * speed;
+  bool is_towards = (distance > 0) == (m_velocity > 0) || m_velocity == 0;
+  if (is_towards && remaining * m_braking_factor > speed_square)
+  {
+    speed = (speed + m_acceleration > m_max_velocity) ? m_max_velocity : speed + m_acceleration;
+    m_velocity = (distance > 0) ? speed : -speed;
+  }
+  else
+  {
+    speed = (speed > m_acceleration) ? speed - m_acceleration : 0;
+    m_velocity = (m_velocity > 0) ? speed : -speed;
+  }
+  m_position += m_velocity;
+  return false;
+}
+
+void Servo_driver::write_pulse()
+{
+  m_servo.writeMicroseconds((m_position + (1 << (fraction_bits - 1))) >> fraction_bits);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file Servo_driver.h
+ * @brief Non-blocking servo driver, smooth move in us steps with speed and acceleration limits, detach after move
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <Servo.h>
+#include <stdint.h>
+
+///< pulse range and motion limits of servo
+struct Servo_limits
+{
+  uint16_t min_pulse_us; ///< pulse for 0 degrees
+  uint16_t max_pulse_us; ///< pulse for 180 degrees
+  uint16_t max_speed; ///< pulse change in us per s
+  uint16_t max_acceleration; ///< pulse change in us per s^2
+  uint16_t min_step_us; ///< smaller change of target is skipped, servo is not turned on for move below its dead band
+};
+
+class Servo_driver
+{
+public:
+  static const uint8_t step_ms = 20; ///< servo PWM period, pulse is changed once per period
+  static const uint8_t fraction_bits = 4; ///< fraction bits of position in us, same as angle fraction from Timeline
+  static const uint8_t max_angle = 180; ///< angle of max_pulse_us
+
+  /**
+   * @brief Construct a new Servo_driver
+   * @param pin: pin to controll pwm for servo
+   * @param move_time_ms: time from end of move to turn off
+   * @param limits: pulse range and motion limits
+   */
+  Servo_driver(uint8_t pin, uint16_t move_time_ms, const Servo_limits& limits);
+
+  /**
+   * @brief set new target, servo goes there in update(), first move after start is done at once
+   * @param position: servo angle in 1/16 degree
+   * @return true target changed
+   * @return false target is closer than min_step_us to previous one, servo stays where it is
+   */
+  bool move(uint16_t position);
+
+  /**
+   * @brief make one step of move every step_ms, turn off PWM move time after end of move, call in every loop pass
+   */
+  void update();
+
+  /**
+   * @brief check if servo is powered
+   * @return true PWM is on
+   * @return false servo is detached
+   */
+  bool is_moving() const;
+
+private:
+  enum class State : uint8_t
+  {
+    idle,
+    moving,
+    settling
+  };
+
+  /**
+   * @brief change velocity by acceleration and move by one step, brake to stop on target
+   * @return true target is reached
+   * @return false move continues
+   */
+  bool step();
+
+  /**
+   * @brief write actual position rounded to us
+   */
+  void write_pulse();
+
+  static const uint16_t m_no_position = 0xFFFF; ///< position not set yet
+
+  Servo m_servo; ///< HW servo
+  const uint8_t m_pin; ///< pin to controll pwm for servo
+  const uint16_t m_move_time_ms; ///< time from end of move to turn off
+  const uint16_t m_min_pulse; ///< pulse for 0 degrees in 1/16 us
+  const uint16_t m_pulse_range_us; ///< pulse change from 0 to 180 degrees
+  const int16_t m_max_velocity; ///< max position change in one step, 1/16 us
+  const int16_t m_acceleration; ///< max velocity change in one step, 1/16 us
+  const int16_t m_braking_factor; ///< 2 * m_acceleration, braking distance v^2 / 2a is checked without division
+  const uint16_t m_min_step; ///< min target change in 1/16 us
+  State m_state; ///< driver state
+  uint16_t m_position; ///< actual pulse in 1/16 us
+  uint16_t m_target; ///< target pulse in 1/16 us
+  int16_t m_velocity; ///< position change in last step
+  unsigned long m_step_ms; ///< time of last step or end of move
+};
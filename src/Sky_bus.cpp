@@ -0,0 +1,106 @@
+/**
+ * @file Sky_bus.cpp
+ * @brief One WS2812 strip shared by sky segments of all clocks, sent once per frame
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Sky_bus.h"
+
+#include "Config.h"
+#include "Dither.h"
+#include "Profiler.h"
+
+#ifdef SUN_CLOCK_SKY_STREAM
+#include "Sky_stream.h"
+#else
+#include "Adafruit_NeoPixel.h"
+#endif
+
+namespace Sky_bus
+{
+namespace
+{
+#ifdef SUN_CLOCK_DITHER
+static_assert(Config::led_ws_count * Dither::ws2812_pixel_us < Config::dither_budget_us, "strip is too long for dither frame");
+static_assert(Config::dither_budget_us < Config::dither_frame_time_ms * 1000UL / 2, "dither frames take more than half of CPU");
+#endif
+
+#ifdef SUN_CLOCK_SKY_STREAM
+Sky_stream m_strip(Config::led_ws_count, Config::led_ws); ///< WS2812 leds, pixels generated during transmission
+#else
+static_assert(Config::led_ws_count <= 300, "NeoPixel buffer takes 3 bytes per LED, use SUN_CLOCK_SKY_STREAM for long strip");
+Adafruit_NeoPixel m_strip(Config::led_ws_count, Config::led_ws, NEO_GRB + NEO_KHZ800); ///< WS2812 leds with framebuffer
+#endif
+
+Sky_segment m_segments[max_segments]; ///< segments sorted by first pixel
+uint8_t m_slots[max_segments] = {}; ///< segment of each clock + 1, 0 = clock has no segment yet
+uint8_t m_count = 0; ///< registered segments
+bool m_is_changed = false; ///< segment set since last show
+
+/**
+ * @brief add segment in order of first pixel, done once for each clock
+ * @param index: clock index
+ * @param first: first pixel of segment
+ * @return uint8_t slot of new segment
+ */
+uint8_t add_segment(uint8_t index, uint16_t first)
+{
+  uint8_t slot = m_count;
+  while (slot > 0 && m_segments[slot - 1].first > first)
+  {
+    m_segments[slot] = m_segments[slot - 1];
+    slot--;
+  }
+  for (uint8_t i = 0; i < max_segments; i++)
+  {
+    if (m_slots[i] > slot)
+    {
+      m_slots[i]++;
+    }
+  }
+  m_slots[index] = slot + 1;
+  m_count++;
+  return slot;
+}
+} // namespace
+
+void begin()
+{
+  m_strip.begin();
+}
+
+void set_segment(uint8_t index, uint16_t first, uint16_t count, const Sky_gradient& gradient)
+{
+  if (index >= max_segments)
+  {
+    return;
+  }
+  uint8_t slot = (m_slots[index] == 0) ? add_segment(index, first) : m_slots[index] - 1;
+  Sky_segment& segment = m_segments[slot];
+  segment = {first, count, gradient};
+  m_is_changed = true;
+#ifndef SUN_CLOCK_SKY_STREAM
+  Profiler::Scope render_scope(Profiler::Stage::sky_render);
+  Sky_renderer::render(m_strip, segment);
+#endif
+}
+
+bool show()
+{
+  if (!m_is_changed)
+  {
+    return false;
+  }
+  // render is done inside show with SUN_CLOCK_SKY_STREAM
+  Profiler::Scope show_scope(Profiler::Stage::sky_show);
+#ifdef SUN_CLOCK_SKY_STREAM
+  m_strip.show(m_segments, m_count);
+#else
+  m_strip.show();
+#endif
+  m_is_changed = false;
+  return true;
+}
+} // namespace Sky_bus
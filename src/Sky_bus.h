@@ -0,0 +1,39 @@
+/**
+ * @file Sky_bus.h
+ * @brief One WS2812 strip shared by sky segments of all clocks, sent once per frame
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Sky_renderer.h"
+
+#include <stdint.h>
+
+namespace Sky_bus
+{
+const uint8_t max_segments = 8; ///< clocks with sky on one strip
+
+/**
+ * @brief init strip pin
+ */
+void begin();
+
+/**
+ * @brief set sky of one clock, with framebuffer pixels are rendered at once, strip is sent later in show()
+ * @param index: clock index, lower than max_segments
+ * @param first: first pixel of segment, segments do not overlap
+ * @param count: pixels of segment
+ * @param gradient: sky colors
+ */
+void set_segment(uint8_t index, uint16_t first, uint16_t count, const Sky_gradient& gradient);
+
+/**
+ * @brief send strip when any segment was set since last show
+ * @return true strip was sent
+ * @return false nothing changed
+ */
+bool show();
+} // namespace Sky_bus
@@ -0,0 +1,23 @@
+/**
+ * @file Sky_renderer.cpp
+ * @brief Horizon to zenith gradient on WS2812 strip
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Sky_renderer.h"
+
+void Sky_renderer::fill_gradient(Adafruit_NeoPixel& strip, uint16_t first, uint16_t last, const Color& from, const Color& to)
+{
+  for_each_gradient_pixel(
+      first, last, last + 1, from, to, [&strip](uint16_t i, uint8_t r, uint8_t g, uint8_t b) { strip.setPixelColor(i, r, g, b); });
+}
+
+void Sky_renderer::render(Adafruit_NeoPixel& strip, const Sky_segment& segment)
+{
+  uint16_t first = segment.first;
+  for_each_pixel(segment.count, segment.gradient, [&strip, first](uint16_t i, uint8_t r, uint8_t g, uint8_t b) {
+    strip.setPixelColor(first + i, r, g, b);
+  });
+}
@@ -0,0 +1,162 @@
+/**
+ * @file Sky_renderer.h
+ * @brief Horizon to zenith gradient on WS2812 strip
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Adafruit_NeoPixel.h"
+#include "Color.h"
+#include "Color_correction.h"
+#include "Dither.h"
+
+#include <stdint.h>
+
+///< sky colors, strip goes from east horizon through zenith to west horizon
+struct Sky_gradient
+{
+  Color east; ///< color on first pixel
+  Color zenith; ///< color on middle pixel
+  Color west; ///< color on last pixel
+
+  bool operator==(const Sky_gradient& other) const
+  {
+    return east == other.east && zenith == other.zenith && west == other.west;
+  }
+
+  bool operator!=(const Sky_gradient& other) const
+  {
+    return !(*this == other);
+  }
+};
+
+///< part of strip with sky of one clock
+struct Sky_segment
+{
+  uint16_t first; ///< first pixel on strip
+  uint16_t count; ///< pixels of segment
+  Sky_gradient gradient; ///< sky colors of segment
+};
+
+namespace Sky_renderer
+{
+/**
+ * @brief add colors, channels are saturated on 255
+ * @param first: first color
+ * @param second: second color
+ * @return Color sum of colors
+ */
+constexpr Color add(const Color& first, const Color& second)
+{
+  return Color((first.r + second.r > 0xFF) ? 0xFF : first.r + second.r,
+               (first.g + second.g > 0xFF) ? 0xFF : first.g + second.g,
+               (first.b + second.b > 0xFF) ? 0xFF : first.b + second.b);
+}
+
+/**
+ * @brief step between pixels in Q8.8, negative steps work by uint16 overflow
+ * @param from: value on first pixel
+ * @param to: value on last pixel
+ * @param pixels: distance from first to last pixel
+ * @return uint16_t step in Q8.8
+ */
+inline uint16_t calculate_step(uint8_t from, uint8_t to, uint16_t pixels)
+{
+  int32_t delta = (static_cast<int32_t>(to) - from) << 8;
+  return static_cast<uint16_t>(delta / pixels);
+}
+
+/**
+ * @brief correct pixel channel by gamma, dark values are dithered with SUN_CLOCK_DITHER
+ * @param channel: color channel
+ * @param value: perceived brightness
+ * @param pixel: pixel index
+ * @return uint8_t value for WS2812
+ */
+inline uint8_t correct_pixel(Colors channel, uint8_t value, uint16_t pixel)
+{
+  if constexpr (Dither::is_enabled)
+  {
+    return Dither::correct(channel, value, pixel);
+  }
+  else
+  {
+    return Color_correction::correct(channel, value);
+  }
+}
+
+/**
+ * @brief generate linear gradient of perceived colors, one add per channel per pixel, pixels corrected by gamma
+ * @param first: first pixel
+ * @param last: last pixel, can be equal first
+ * @param end: pixel after last generated one, lower than last + 1 leaves end of gradient out
+ * @param from: color on first pixel
+ * @param to: color on last pixel
+ * @param output: called for every pixel with index and corrected r, g, b
+ */
+template <typename Output>
+void for_each_gradient_pixel(uint16_t first, uint16_t last, uint16_t end, const Color& from, const Color& to, Output&& output)
+{
+  uint16_t pixels = (last > first) ? last - first : 1;
+  uint16_t step_r = calculate_step(from.r, to.r, pixels);
+  uint16_t step_g = calculate_step(from.g, to.g, pixels);
+  uint16_t step_b = calculate_step(from.b, to.b, pixels);
+
+  // Q8.8, half added for rounding
+  uint16_t r = (from.r << 8) | 0x80;
+  uint16_t g = (from.g << 8) | 0x80;
+  uint16_t b = (from.b << 8) | 0x80;
+  for (uint16_t i = first; i < end; i++)
+  {
+    output(i, correct_pixel(Colors::red, r >> 8, i), correct_pixel(Colors::green, g >> 8, i), correct_pixel(Colors::blue, b >> 8, i));
+    r += step_r;
+    g += step_g;
+    b += step_b;
+  }
+}
+
+/**
+ * @brief generate every pixel of sky gradient once, in strip order
+ * @details odd strip has one zenith pixel shared by both halves, even strip has two
+ * @param count: pixels in strip
+ * @param gradient: sky colors
+ * @param output: called for every pixel with index and corrected r, g, b
+ */
+template <typename Output>
+void for_each_pixel(uint16_t count, const Sky_gradient& gradient, Output&& output)
+{
+  if (count == 0)
+  {
+    return;
+  }
+  if (count == 1)
+  {
+    for_each_gradient_pixel(0, 0, 1, gradient.east, gradient.zenith, output);
+    return;
+  }
+  uint16_t middle = (count - 1) / 2;
+  uint16_t second_half = (count & 1) ? middle : middle + 1;
+  for_each_gradient_pixel(0, middle, second_half, gradient.east, gradient.zenith, output);
+  for_each_gradient_pixel(second_half, count - 1, count, gradient.zenith, gradient.west, output);
+}
+
+/**
+ * @brief fill pixels with linear gradient of perceived colors, pixels corrected by gamma
+ * @param strip: WS2812 leds
+ * @param first: first pixel
+ * @param last: last pixel, can be equal first
+ * @param from: color on first pixel
+ * @param to: color on last pixel
+ */
+void fill_gradient(Adafruit_NeoPixel& strip, uint16_t first, uint16_t last, const Color& from, const Color& to);
+
+/**
+ * @brief fill part of strip with sky gradient, without show()
+ * @param strip: WS2812 leds
+ * @param segment: pixels and sky colors, dither pattern is counted from first pixel of segment
+ */
+void render(Adafruit_NeoPixel& strip, const Sky_segment& segment);
+} // namespace Sky_renderer
@@ -0,0 +1,116 @@
+/**
+ * @file Sky_stream.cpp
+ * @brief WS2812 sky strip without framebuffer, pixels are generated from gradient during transmission
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Sky_stream.h"
+
+#include <Arduino.h>
+
+#ifndef __AVR__
+#include "Hal_native.h"
+#endif
+
+#ifdef __AVR__
+static_assert(F_CPU == 16000000UL, "WS2812 timing is written for 16 MHz");
+
+namespace
+{
+/**
+ * @brief send byte MSB first, 20 cycles (1.25 us) per bit: 5 high, 7 high for 1 or low for 0, 8 low
+ * @details line stays low after last bit, next byte can start few us later without latch
+ */
+inline void send_byte(volatile uint8_t* port, uint8_t high, uint8_t low, uint8_t value)
+{
+  uint8_t next = low;
+  uint8_t bit = 8;
+  asm volatile(
+      "1:"                         "\n\t" //                          T = 0
+      "st   %a[port], %[high]"     "\n\t" // 2    PORT = high         T = 2
+      "sbrc %[value], 7"           "\n\t" // 1-2  if (value & 0x80)
+      "mov  %[next], %[high]"      "\n\t" // 0-1    next = high       T = 4
+      "lsl  %[value]"              "\n\t" // 1    value <<= 1         T = 5
+      "st   %a[port], %[next]"     "\n\t" // 2    PORT = next         T = 7
+      "mov  %[next], %[low]"       "\n\t" // 1    next = low          T = 8
+      "rjmp .+0"                   "\n\t" // 2                        T = 10
+      "rjmp .+0"                   "\n\t" // 2                        T = 12
+      "st   %a[port], %[low]"      "\n\t" // 2    PORT = low          T = 14
+      "dec  %[bit]"                "\n\t" // 1    bit--               T = 15
+      "rjmp .+0"                   "\n\t" // 2                        T = 17
+      "nop"                        "\n\t" // 1                        T = 18
+      "brne 1b"                    "\n\t" // 2    if (bit) next bit   T = 20 -> 0
+      : [value] "+r"(value), [next] "+r"(next), [bit] "+r"(bit)
+      : [port] "e"(port), [high] "r"(high), [low] "r"(low));
+}
+} // namespace
+#endif
+
+Sky_stream::Sky_stream(uint16_t count, uint8_t pin)
+: m_count(count)
+, m_pin(pin)
+{}
+
+void Sky_stream::begin()
+{
+  pinMode(m_pin, OUTPUT);
+  digitalWrite(m_pin, LOW);
+#ifdef __AVR__
+  m_port = portOutputRegister(digitalPinToPort(m_pin));
+  m_mask = digitalPinToBitMask(m_pin);
+#endif
+}
+
+void Sky_stream::show(const Sky_segment* segments, uint8_t segment_count)
+{
+  unsigned long since_show_us = micros() - m_last_show_us;
+  if (since_show_us < latch_us)
+  {
+    delayMicroseconds(latch_us - since_show_us);
+  }
+  // gradient step, gamma lookup and pending interrupts between pixels take few us, far below latch time
+  uint16_t sent = 0;
+  for (uint8_t i = 0; i < segment_count; i++)
+  {
+    const Sky_segment& segment = segments[i];
+    for (; sent < segment.first && sent < m_count; sent++)
+    {
+      send(0, 0, 0);
+    }
+    uint16_t count = (segment.first + segment.count > m_count) ? m_count - sent : segment.count;
+    Sky_renderer::for_each_pixel(count, segment.gradient, [this](uint16_t, uint8_t r, uint8_t g, uint8_t b) { send(r, g, b); });
+    sent += count;
+  }
+  for (; sent < m_count; sent++)
+  {
+    send(0, 0, 0);
+  }
+#ifndef __AVR__
+  Hal_native::latch_ws2812();
+#endif
+  m_last_show_us = micros();
+}
+
+uint16_t Sky_stream::get_count() const
+{
+  return m_count;
+}
+
+void Sky_stream::send(uint8_t r, uint8_t g, uint8_t b)
+{
+#ifdef __AVR__
+  // interrupts are blocked only inside pixel, so millis() and UART work during long strip
+  noInterrupts();
+  // other pins of port (e.g. sun LED with PWM 0 or 255) can change between pixels
+  uint8_t high = *m_port | m_mask;
+  uint8_t low = *m_port & ~m_mask;
+  send_byte(m_port, high, low, g);
+  send_byte(m_port, high, low, r);
+  send_byte(m_port, high, low, b);
+  interrupts();
+#else
+  Hal_native::send_ws2812_pixel(r, g, b);
+#endif
+}
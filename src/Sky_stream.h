@@ -0,0 +1,59 @@
+/**
+ * @file Sky_stream.h
+ * @brief WS2812 sky strip without framebuffer, pixels are generated from gradient during transmission
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Sky_renderer.h"
+
+#include <stdint.h>
+
+class Sky_stream
+{
+public:
+  static const uint16_t latch_us = 300; ///< low time after which WS2812 shows received pixels, WS2812B since V5 needs over 280 us
+
+  /**
+   * @brief Construct a new Sky_stream, RAM does not depend on pixels count
+   * @param count: pixels in strip
+   * @param pin: data pin
+   */
+  Sky_stream(uint16_t count, uint8_t pin);
+
+  /**
+   * @brief set data pin as output
+   */
+  void begin();
+
+  /**
+   * @brief generate and send all pixels, interrupts are disabled only for 30 us of each pixel (AVR 16 MHz)
+   * @param segments: parts of strip sorted by first pixel, pixels between and after them are black
+   * @param segment_count: number of segments
+   */
+  void show(const Sky_segment* segments, uint8_t segment_count);
+
+  /**
+   * @brief get pixels count
+   * @return uint16_t pixels in strip
+   */
+  uint16_t get_count() const;
+
+private:
+  /**
+   * @brief send one pixel in GRB order
+   * @param r: red
+   * @param g: green
+   * @param b: blue
+   */
+  void send(uint8_t r, uint8_t g, uint8_t b);
+
+  const uint16_t m_count; ///< pixels in strip
+  const uint8_t m_pin; ///< data pin
+  volatile uint8_t* m_port = nullptr; ///< output register of data pin
+  uint8_t m_mask = 0; ///< data pin bit in port
+  unsigned long m_last_show_us = 0; ///< micros() on end of last transmission
+};
@@ -0,0 +1,37 @@
+/**
+ * @file Sun_clock.cpp
+ * @brief Time helpers shared by all clocks, Sun_clock template members are defined in Sun_clock.h
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Sun_clock.h"
+
+#include "Log.h"
+
+#include <Arduino.h>
+
+const uint8_t m_sec_in_min = 60; ///< seconds in minute
+
+DateTime calculate_from_minutes(uint16_t total_min)
+{
+  auto minutes = total_min % min_in_h;
+  auto houres = (total_min - minutes) / min_in_h;
+  return DateTime(1970, 1, 1, houres, minutes);
+}
+
+void print_time(DateTime time)
+{
+  Log::out.print(time.hour(), DEC);
+  Log::out.print(':');
+  Log::out.print(time.minute(), DEC);
+  Log::out.print(':');
+  Log::out.println(time.second(), DEC);
+}
+
+uint32_t calculate_from_datetime(DateTime time)
+{
+  uint16_t seconds = (time.minute() * m_sec_in_min) + time.second();
+  return minutes_to_ms(time.hour() * min_in_h) + seconds * 1000UL;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file Sun_clock.h
+ * @brief Sun and sky calculation stages of clock, outputs and day are given by compile time policy
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "Color_correction.h"
+#include "Config.h"
+#include "Dither.h"
+#include "Ephemeris.h"
+#include "Log.h"
+#include "Output_stats.h"
+#include "Profiler.h"
+#include "RTClib.h"
+#include "Servo_driver.h"
+#include "Sky_bus.h"
+#include "Sky_renderer.h"
+#include "Timeline.h"
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+#include "sunset.h"
+#endif
+
+const uint8_t min_in_h = 60; ///< minutes in hour
+const uint32_t ms_in_min = 60000UL; ///< ms in minute
+const uint32_t ms_in_day = 86400000UL; ///< ms in day
+
+/**
+ * @brief convert minutes to ms
+ * @param minutes: time in minutes
+ * @return uint32_t time in ms
+ */
+inline uint32_t minutes_to_ms(uint16_t minutes)
+{
+  return minutes * ms_in_min;
+}
+
+/**
+ * @brief calculate minutes form 0:00 to hour and minutes
+ * @param total_min: minutes form 0:00
+ * @return DateTime calculated time
+ */
+DateTime calculate_from_minutes(uint16_t total_min);
+
+/**
+ * @brief print time on log hh:mm:ss
+ * @param time: time to print
+ */
+void print_time(DateTime time);
+
+/**
+ * @brief calculate ms form 0:00
+ * @param time: time to calculate
+ * @return uint32_t calculated ms
+ */
+uint32_t calculate_from_datetime(DateTime time);
+
+///< member of disabled stage, has no code and takes one byte
+struct No_output
+{
+  /**
+   * @brief Construct a new No_output, arguments of real output are ignored
+   */
+  template <typename... Args>
+  explicit No_output(const Args&...)
+  {}
+};
+
+///< type for true condition, otherwise second type, <type_traits> is not available on AVR
+template <bool condition, typename True_type, typename False_type>
+struct Select
+{
+  typedef True_type type;
+};
+
+template <typename True_type, typename False_type>
+struct Select<false, True_type, False_type>
+{
+  typedef False_type type;
+};
+
+#ifndef SUN_CLOCK_RUNTIME_EPHEMERIS
+/**
+ * @brief convert degrees to template parameter, double can not be template parameter
+ * @param degrees: latitude or longitude
+ * @return int32_t degrees in millionths, about 0.1 m
+ */
+constexpr int32_t to_micro_degrees(double degrees)
+{
+  return static_cast<int32_t>(degrees * 1e6 + ((degrees < 0) ? -0.5 : 0.5));
+}
+
+///< sun events of one location in flash, clocks with same location and timezone use one table
+template <int32_t latitude_e6, int32_t longitude_e6, int8_t tz_offset>
+struct Location_table
+{
+  static constexpr Ephemeris::Year_table table PROGMEM =
+      Ephemeris::make_year_table(Config::ephemeris_year, latitude_e6 / 1e6, longitude_e6 / 1e6, tz_offset); ///< 2928 B
+};
+#endif
+
+/**
+ * @brief clock with all values of Config_policy folded by compiler, stages turned off in policy are removed
+ * @details Config_policy has static constexpr members: has_servo, has_sky, pin_led_r, pin_led_g, pin_led_b, pin_servo,
+ * servo_move_time_ms, servo_min_pulse_us, servo_max_pulse_us, servo_max_speed, servo_max_acceleration, servo_min_step_us, sky_first,
+ * sky_count, latitude, longitude, tz_offset, keyframes, keyframe_count; see Config::Clock_policy
+ */
+template <typename Config_policy>
+class Sun_clock
+{
+public:
+  /**
+   * @brief Construct a new Sun_clock with location from policy
+   * @param index: clock number, sky segment on shared strip
+   */
+  explicit Sun_clock(uint8_t index = 0);
+
+  /**
+   * @brief get clock number
+   * @return uint8_t index from constructor
+   */
+  uint8_t get_index() const;
+
+  /**
+   * @brief calculate sunrise and sunset times
+   * @param date: day for calculation
+   * @return Ephemeris::Day_events events in local time
+   */
+  Ephemeris::Day_events calculate_day_events(const DateTime& date);
+
+  /**
+   * @brief get location and timezone of sun events
+   * @return const Ephemeris::Location& location from policy or set_location()
+   */
+  const Ephemeris::Location& get_location() const;
+
+  /**
+   * @brief change location and timezone, used from next calculate_day_events()
+   * @param location: new location and timezone
+   * @return true location is changed
+   * @return false position can be changed only with SUN_CLOCK_RUNTIME_EPHEMERIS, table is calculated for Config location
+   */
+  bool set_location(const Ephemeris::Location& location);
+
+  /**
+   * @brief calculate keyframes of day from sun events
+   * @param events: events in local time
+   */
+  void set_day_events(const Ephemeris::Day_events& events);
+
+  /**
+   * @brief change keyframe color and rebuild keyframes of actual day, sun events are not calculated again
+   * @param keyframe: keyframe index
+   * @param layer: sun or one of sky colors
+   * @param color: new color, perceived brightness
+   * @return true color is changed
+   * @return false keyframe index is out of range or there is no space for more colors
+   */
+  bool set_keyframe_color(uint8_t keyframe, Layer layer, const Color& color);
+
+  /**
+   * @brief calculate sunrise and sunset times and keyframes of day
+   * @param date: day for calculation
+   */
+  void calculate_sunrise_sunset(const DateTime& date);
+
+  /**
+   * @brief get outputs from day timeline
+   * @param now: time in ms from 0:00
+   * @return Scene sun color, sky colors and servo angle
+   */
+  Scene get_scene(uint32_t now);
+
+  /**
+   * @brief get timeline of actual day
+   * @return const Timeline& keyframes and cursor
+   */
+  const Timeline& get_timeline() const;
+
+  /**
+   * @brief estimate when outputs change next time, call after render_frame()
+   * @param now: time in ms from 0:00
+   * @return uint32_t time in ms from 0:00 of next change, can be after end of day
+   */
+  uint32_t get_next_change(uint32_t now) const;
+
+  /**
+   * @brief check if outputs keep state without timers, servo is off and sun PWM is 0 or 255
+   * @return true power down is possible
+   * @return false timers are needed
+   */
+  bool is_output_static() const;
+
+  /**
+   * @brief init pins, shared strip is started by Sky_bus::begin()
+   */
+  void init_outputs();
+
+  /**
+   * @brief set servo target, servo moves smoothly in update_servo() and is turned off after move
+   * @param servo_position: servo angle in 1/16 degree
+   */
+  void move_servo(uint16_t servo_position);
+
+  /**
+   * @brief make servo steps and turn off servo after move time, call in every loop pass
+   */
+  void update_servo();
+
+  /**
+   * @brief Set the sun rgb object
+   * @param color: sun color, corrected by gamma before PWM
+   */
+  void set_sun_rgb(const Color& color);
+
+  /**
+   * @brief Set the sky rgb on own segment of strip, strip is sent by Sky_bus::show()
+   * @param gradient: sky colors
+   */
+  void set_sky_rgb(const Sky_gradient& gradient);
+
+  /**
+   * @brief calculate and set all outputs for one animation frame, Dither::next_frame() and Sky_bus::show() are called by owner
+   * @param now: local time of clock in ms from 0:00
+   * @param is_logged: print colors on debug log
+   */
+  void render_frame(uint32_t now, bool is_logged);
+
+  /**
+   * @brief check if outputs of last frame are dithered
+   * @return true refresh_dither() should be called every dither_frame_time_ms
+   * @return false outputs are static until next change
+   */
+  bool is_dithering() const;
+
+  /**
+   * @brief set sun and sky of last frame again with actual dither pattern, timeline is not evaluated
+   */
+  void refresh_dither();
+
+  /**
+   * @brief print committed and skipped updates of outputs on log
+   */
+  void print_output_stats() const;
+
+  /**
+   * @brief clear committed and skipped updates, counts are per stats period
+   */
+  void reset_output_stats();
+
+private:
+  typedef typename Select<Config_policy::has_servo, Servo_driver, No_output>::type Servo_output;
+
+#ifndef SUN_CLOCK_RUNTIME_EPHEMERIS
+  typedef Location_table<to_micro_degrees(Config_policy::latitude), to_micro_degrees(Config_policy::longitude), Config_policy::tz_offset>
+      Events_table; ///< sun events of policy location, shared with other clocks in same place
+#endif
+
+  /**
+   * @brief move event from table to actual timezone, wrapped to day like local time of clock in Clock_group
+   * @param minutes: event time in policy timezone
+   * @return uint16_t event time in actual timezone
+   */
+  uint16_t shift_timezone(uint16_t minutes) const;
+
+  /**
+   * @brief write PWM only when value changed since last frame
+   * @param pin: PWM pin
+   * @param value: new value
+   * @param last_value: value from last frame, updated when written
+   */
+  void write_pwm(uint8_t pin, uint8_t value, uint8_t& last_value);
+
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+  SunSet m_sunset; ///< Sun position calculation
+#endif
+  const uint8_t m_index; ///< clock number
+  Ephemeris::Location m_location; ///< location from policy or serial
+  Ephemeris::Day_events m_events; ///< events of actual day, keyframes are rebuilt from them after color change
+  Timeline m_timeline; ///< keyframes of actual day
+  Servo_output m_servo; ///< HW servo
+
+  Color m_last_sun; ///< corrected sun color committed to PWM
+  Color m_sun; ///< perceived sun color of last frame, dithered again in refresh_dither()
+  Color m_sun_residual; ///< fraction of sun channels not sent yet to PWM
+  Sky_gradient m_last_sky; ///< sky colors committed to strip
+  bool m_is_output_set = false; ///< last frame is valid, false forces writing all outputs
+  bool m_is_dithered = false; ///< last frame has dithered outputs, refresh_dither() is needed
+  Output_stats m_output_stats = {}; ///< committed and skipped updates
+};
+
+template <typename Config_policy>
+Sun_clock<Config_policy>::Sun_clock(uint8_t index)
+:
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+  m_sunset(Config_policy::latitude, Config_policy::longitude, Config_policy::tz_offset)
+,
+#endif
+  m_index(index)
+, m_location{Config_policy::latitude, Config_policy::longitude, Config_policy::tz_offset}
+, m_servo(Config_policy::pin_servo,
+          Config_policy::servo_move_time_ms,
+          Servo_limits{Config_policy::servo_min_pulse_us,
+                       Config_policy::servo_max_pulse_us,
+                       Config_policy::servo_max_speed,
+                       Config_policy::servo_max_acceleration,
+                       Config_policy::servo_min_step_us})
+{
+  static_assert(!Config_policy::has_sky || Config_policy::sky_first + Config_policy::sky_count <= Config::led_ws_count,
+                "sky segment is out of strip");
+  static_assert(Config_policy::keyframe_count <= Timeline::max_keyframes, "too many keyframes");
+}
+
+template <typename Config_policy>
+uint8_t Sun_clock<Config_policy>::get_index() const
+{
+  return m_index;
+}
+
+template <typename Config_policy>
+uint16_t Sun_clock<Config_policy>::shift_timezone(uint16_t minutes) const
+{
+  // two days keep sum positive for any timezone difference
+  int16_t shift = (m_location.tz_offset - Config_policy::tz_offset) * min_in_h;
+  return (minutes + 2 * Ephemeris::min_in_day + shift) % Ephemeris::min_in_day;
+}
+
+template <typename Config_policy>
+Ephemeris::Day_events Sun_clock<Config_policy>::calculate_day_events(const DateTime& date)
+{
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+  m_sunset.setCurrentDate(date.year(), date.month(), date.day());
+  Ephemeris::Day_events events;
+  events.sunrise = static_cast<uint16_t>(m_sunset.calcSunrise());
+  events.sunset = static_cast<uint16_t>(m_sunset.calcSunset());
+  events.sunrise_civil = static_cast<uint16_t>(m_sunset.calcCivilSunrise());
+  events.sunset_civil = static_cast<uint16_t>(m_sunset.calcCivilSunset());
+  return events;
+#else
+  Ephemeris::Day_events events = Ephemeris::get_day_events(Events_table::table, date.month(), date.day());
+  events.sunrise_civil = shift_timezone(events.sunrise_civil);
+  events.sunrise = shift_timezone(events.sunrise);
+  events.sunset = shift_timezone(events.sunset);
+  events.sunset_civil = shift_timezone(events.sunset_civil);
+  return events;
+#endif
+}
+
+template <typename Config_policy>
+const Ephemeris::Location& Sun_clock<Config_policy>::get_location() const
+{
+  return m_location;
+}
+
+template <typename Config_policy>
+bool Sun_clock<Config_policy>::set_location(const Ephemeris::Location& location)
+{
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+  m_sunset.setPosition(location.latitude, location.longitude, static_cast<int>(location.tz_offset));
+#else
+  if (location.latitude != m_location.latitude || location.longitude != m_location.longitude)
+  {
+    return false;
+  }
+#endif
+  m_location = location;
+  return true;
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::set_day_events(const Ephemeris::Day_events& events)
+{
+  m_events = events;
+  m_timeline.build(Config_policy::keyframes, Config_policy::keyframe_count, events);
+
+  if constexpr (Log::is_info)
+  {
+    Log::out.print(F("Sunrise civil: "));
+    print_time(calculate_from_minutes(events.sunrise_civil));
+    Log::out.print(F("Sunrise: "));
+    print_time(calculate_from_minutes(events.sunrise));
+    Log::out.print(F("Sunset: "));
+    print_time(calculate_from_minutes(events.sunset));
+    Log::out.print(F("Sunset civil: "));
+    print_time(calculate_from_minutes(events.sunset_civil));
+  }
+  if constexpr (Log::is_debug)
+  {
+    for (uint8_t i = 0; i < m_timeline.get_count(); i++)
+    {
+      const Keyframe& keyframe = m_timeline.get_keyframe(i);
+      Log::out.print(F("keyframe: "));
+      print_time(calculate_from_minutes(keyframe.time / ms_in_min));
+    }
+  }
+}
+
+template <typename Config_policy>
+bool Sun_clock<Config_policy>::set_keyframe_color(uint8_t keyframe, Layer layer, const Color& color)
+{
+  if (keyframe >= Config_policy::keyframe_count || !m_timeline.set_color(keyframe, layer, color))
+  {
+    return false;
+  }
+  m_timeline.build(Config_policy::keyframes, Config_policy::keyframe_count, m_events);
+  return true;
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::calculate_sunrise_sunset(const DateTime& date)
+{
+  set_day_events(calculate_day_events(date));
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::move_servo(uint16_t servo_position)
+{
+  if constexpr (Config_policy::has_servo)
+  {
+    Profiler::Scope scope(Profiler::Stage::servo);
+    bool is_moved = m_servo.move(servo_position);
+    m_output_stats.servo.count(is_moved);
+    if constexpr (Log::is_debug)
+    {
+      if (is_moved)
+      {
+        Log::out.print(F("servo pos 1/16 deg: "));
+        Log::out.println(servo_position);
+      }
+    }
+  }
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::update_servo()
+{
+  if constexpr (Config_policy::has_servo)
+  {
+    Profiler::Scope scope(Profiler::Stage::servo);
+    m_servo.update();
+  }
+}
+
+template <typename Config_policy>
+Scene Sun_clock<Config_policy>::get_scene(uint32_t now)
+{
+  return m_timeline.evaluate(now);
+}
+
+template <typename Config_policy>
+const Timeline& Sun_clock<Config_policy>::get_timeline() const
+{
+  return m_timeline;
+}
+
+template <typename Config_policy>
+uint32_t Sun_clock<Config_policy>::get_next_change(uint32_t now) const
+{
+  uint32_t next_change = m_timeline.get_next_change(now);
+  if (m_is_dithered && next_change - now > Config::dither_frame_time_ms)
+  {
+    return now + Config::dither_frame_time_ms;
+  }
+  return next_change;
+}
+
+template <typename Config_policy>
+bool Sun_clock<Config_policy>::is_output_static() const
+{
+  // analogWrite() with 0 or 255 sets pin as digital output
+  auto is_digital = [](uint8_t value) { return value == 0 || value == 0xFF; };
+  bool is_servo_off = true;
+  if constexpr (Config_policy::has_servo)
+  {
+    is_servo_off = !m_servo.is_moving();
+  }
+  return is_servo_off && !m_is_dithered && is_digital(m_last_sun.r) && is_digital(m_last_sun.g) && is_digital(m_last_sun.b);
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::write_pwm(uint8_t pin, uint8_t value, uint8_t& last_value)
+{
+  bool is_changed = !m_is_output_set || value != last_value;
+  m_output_stats.sun.count(is_changed);
+  if (is_changed)
+  {
+    analogWrite(pin, value);
+    last_value = value;
+  }
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::set_sun_rgb(const Color& color)
+{
+  Profiler::Scope scope(Profiler::Stage::sun_pwm);
+  m_sun = color;
+  Color output;
+  if constexpr (Dither::is_enabled)
+  {
+    output.r = Dither::diffuse(Colors::red, color.r, m_sun_residual.r);
+    output.g = Dither::diffuse(Colors::green, color.g, m_sun_residual.g);
+    output.b = Dither::diffuse(Colors::blue, color.b, m_sun_residual.b);
+  }
+  else
+  {
+    output = Color_correction::correct(color);
+  }
+  write_pwm(Config_policy::pin_led_r, output.r, m_last_sun.r);
+  write_pwm(Config_policy::pin_led_g, output.g, m_last_sun.g);
+  write_pwm(Config_policy::pin_led_b, output.b, m_last_sun.b);
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::set_sky_rgb(const Sky_gradient& gradient)
+{
+  if constexpr (Config_policy::has_sky)
+  {
+    // dithered pixels change in every frame
+    bool is_changed = !m_is_output_set || gradient != m_last_sky || m_is_dithered;
+    m_output_stats.sky.count(is_changed);
+    if (is_changed)
+    {
+      Sky_bus::set_segment(m_index, Config_policy::sky_first, Config_policy::sky_count, gradient);
+      m_last_sky = gradient;
+    }
+  }
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::render_frame(uint32_t now, bool is_logged)
+{
+  Profiler::Scope scope(Profiler::Stage::frame);
+  Scene scene = get_scene(now);
+  move_servo(m_timeline.get_servo_position(now));
+  set_sun_rgb(scene.sun);
+  set_sky_rgb(scene.sky);
+  m_is_output_set = true;
+  if constexpr (Dither::is_enabled)
+  {
+    m_is_dithered = Dither::take_active();
+  }
+
+  if constexpr (Log::is_debug)
+  {
+    if (is_logged)
+    {
+      Log::out.print(F("sun "));
+      scene.sun.print_color();
+      Log::out.print(F("sky "));
+      scene.sky.zenith.print_color();
+      Log::out.print(F("sky east "));
+      scene.sky.east.print_color();
+      Log::out.print(F("sky west "));
+      scene.sky.west.print_color();
+    }
+  }
+}
+
+template <typename Config_policy>
+bool Sun_clock<Config_policy>::is_dithering() const
+{
+  return m_is_dithered;
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::refresh_dither()
+{
+  if constexpr (Dither::is_enabled)
+  {
+    Profiler::Scope scope(Profiler::Stage::dither);
+    set_sun_rgb(m_sun);
+    set_sky_rgb(m_last_sky);
+    m_is_dithered = Dither::take_active();
+  }
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::init_outputs()
+{
+  pinMode(Config_policy::pin_led_r, OUTPUT);
+  pinMode(Config_policy::pin_led_g, OUTPUT);
+  pinMode(Config_policy::pin_led_b, OUTPUT);
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::print_output_stats() const
+{
+  Log::out.print(F("committed/skipped sun pwm: "));
+  Log::out.print(m_output_stats.sun.committed);
+  Log::out.print('/');
+  Log::out.print(m_output_stats.sun.skipped);
+  Log::out.print(F(" sky show: "));
+  Log::out.print(m_output_stats.sky.committed);
+  Log::out.print('/');
+  Log::out.print(m_output_stats.sky.skipped);
+  Log::out.print(F(" servo: "));
+  Log::out.print(m_output_stats.servo.committed);
+  Log::out.print('/');
+  Log::out.println(m_output_stats.servo.skipped);
+}
+
+template <typename Config_policy>
+void Sun_clock<Config_policy>::reset_output_stats()
+{
+  m_output_stats = {};
+}
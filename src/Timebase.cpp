@@ -0,0 +1,140 @@
+/**
+ * @file Timebase.cpp
+ * @brief Time of day counted from DS1307 1 Hz square wave
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Timebase.h"
+
+#include <Arduino.h>
+
+namespace
+{
+uint8_t m_pin = 0; ///< SQW pin
+volatile uint32_t m_seconds = 0; ///< SQW falling edges from start
+volatile unsigned long m_edge_millis = 0; ///< millis() on last edge
+volatile uint8_t m_last_level = HIGH; ///< SQW level in last pin change interrupt
+volatile bool m_is_wake_needed = false; ///< interrupt since clear_wake() was not rising SQW edge
+int32_t m_seconds_offset = 0; ///< seconds of day minus counted seconds on last sync
+uint32_t m_sync_seconds = 0; ///< counted seconds on last sync
+
+/**
+ * @brief count one second, DS1307 changes seconds register on falling edge
+ */
+void on_sqw_edge()
+{
+  m_seconds++;
+  m_edge_millis = millis();
+}
+
+/**
+ * @brief read counter and time of last edge without interrupt between
+ */
+void read_counter(uint32_t& seconds, unsigned long& edge_millis)
+{
+  noInterrupts();
+  seconds = m_seconds;
+  edge_millis = m_edge_millis;
+  interrupts();
+}
+
+/**
+ * @brief pin change comes on both SQW edges and on other pins of port (serial RX wake), only falling SQW edge is second
+ */
+void on_pin_change()
+{
+  uint8_t level = digitalRead(m_pin);
+  if (level == m_last_level)
+  {
+    m_is_wake_needed = true;
+    return;
+  }
+  if (level == LOW)
+  {
+    on_sqw_edge();
+    m_is_wake_needed = true;
+  }
+  m_last_level = level;
+}
+} // namespace
+
+#ifdef __AVR__
+ISR(PCINT2_vect)
+{
+  on_pin_change();
+}
+#endif
+
+void Timebase::begin(uint8_t pin)
+{
+  m_pin = pin;
+  pinMode(pin, INPUT_PULLUP);
+  m_last_level = digitalRead(pin);
+  m_edge_millis = millis();
+#ifdef __AVR__
+  *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+  *digitalPinToPCICR(pin) |= _BV(digitalPinToPCICRbit(pin));
+#else
+  // same handling of both edges as pin change interrupt
+  attachInterrupt(digitalPinToInterrupt(pin), on_pin_change, CHANGE);
+#endif
+}
+
+void Timebase::clear_wake()
+{
+  m_is_wake_needed = false;
+}
+
+bool Timebase::is_wake_needed()
+{
+  return m_is_wake_needed;
+}
+
+void Timebase::sync(uint32_t seconds)
+{
+  uint32_t now = get_time_ms() / 1000;
+  m_seconds_offset = static_cast<int32_t>(seconds - now);
+  m_sync_seconds = now;
+}
+
+bool Timebase::is_sync_due(uint32_t sync_time_s)
+{
+  uint32_t now = get_time_ms() / 1000;
+  return now - m_sync_seconds >= sync_time_s || static_cast<int32_t>(now) + m_seconds_offset >= static_cast<int32_t>(sec_in_day);
+}
+
+bool Timebase::is_sqw_running()
+{
+  uint32_t counter;
+  unsigned long edge_millis;
+  read_counter(counter, edge_millis);
+  return millis() - edge_millis < sqw_timeout_ms;
+}
+
+uint32_t Timebase::get_time_ms()
+{
+  uint32_t counter;
+  unsigned long edge_millis;
+  read_counter(counter, edge_millis);
+  unsigned long since_edge = millis() - edge_millis;
+  // next edge is late only when SQW is missing, then millis() counts alone
+  if (since_edge > 999 && since_edge < sqw_timeout_ms)
+  {
+    since_edge = 999;
+  }
+  return counter * 1000UL + since_edge;
+}
+
+uint32_t Timebase::get_time_of_day()
+{
+  uint32_t time_ms = get_time_ms();
+  int32_t seconds = static_cast<int32_t>(time_ms / 1000) + m_seconds_offset;
+  seconds %= static_cast<int32_t>(sec_in_day);
+  if (seconds < 0)
+  {
+    seconds += sec_in_day;
+  }
+  return static_cast<uint32_t>(seconds) * 1000UL + time_ms % 1000;
+}
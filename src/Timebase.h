@@ -0,0 +1,70 @@
+/**
+ * @file Timebase.h
+ * @brief Time of day counted from DS1307 1 Hz square wave
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace Timebase
+{
+const uint32_t sec_in_day = 86400UL; ///< seconds in day
+const uint16_t sqw_timeout_ms = 1500; ///< time without SQW edge after which millis() is used
+
+/**
+ * @brief start counting falling edges of SQW, pin is pulled up (SQW is open drain)
+ * @details on AVR pin change interrupt is used, it also wakes MCU from power down. It comes on both edges, so MCU wakes every 0.5 s,
+ * rising edge is only marked as not needing main loop, see is_wake_needed()
+ * @param pin: pin with DS1307 SQW, 0 - 7 on AVR
+ */
+void begin(uint8_t pin);
+
+/**
+ * @brief forget interrupts which came before, call with interrupts disabled before power down
+ */
+void clear_wake();
+
+/**
+ * @brief check if interrupt since clear_wake() needs main loop
+ * @return true falling SQW edge (next second) or pin change of other pin (serial RX)
+ * @return false no interrupt or only rising SQW edge, MCU can sleep again
+ */
+bool is_wake_needed();
+
+/**
+ * @brief set time of day from RTC read
+ * @param seconds: seconds from 0:00
+ */
+void sync(uint32_t seconds);
+
+/**
+ * @brief check if RTC should be read again
+ * @param sync_time_s: time between RTC reads in seconds
+ * @return true time from sync passed or day changed (date and sunrise are needed)
+ * @return false counted time is valid
+ */
+bool is_sync_due(uint32_t sync_time_s);
+
+/**
+ * @brief check if SQW edges come
+ * @return true last edge was less than sqw_timeout_ms ago
+ * @return false SQW is not connected, time is counted with millis()
+ */
+bool is_sqw_running();
+
+/**
+ * @brief monotonic time from start, full seconds from SQW and ms from millis() after last edge
+ * @return uint32_t time in ms
+ */
+uint32_t get_time_ms();
+
+/**
+ * @brief time of day from last RTC read and SQW seconds
+ * @return uint32_t time in ms from 0:00
+ */
+uint32_t get_time_of_day();
+} // namespace Timebase
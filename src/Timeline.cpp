@@ -0,0 +1,319 @@
+/**
+ * @file Timeline.cpp
+ * @brief Keyframes of sun, sky and servo anchored to sun events
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Timeline.h"
+
+#include "Fixed_point.h"
+
+#include <Arduino.h>
+
+namespace
+{
+const int16_t m_min_in_day = 1440; ///< minutes in day
+const uint32_t m_ms_in_min = 60000UL; ///< ms in minute
+const uint32_t m_ms_in_day = 86400000UL; ///< ms in day
+
+/**
+ * @brief time of sun event, noon is in the middle between sunrise and sunset
+ */
+uint16_t get_event_time(Sun_event event, const Ephemeris::Day_events& events)
+{
+  switch (event)
+  {
+    case Sun_event::sunrise_civil:
+      return events.sunrise_civil;
+    case Sun_event::sunrise:
+      return events.sunrise;
+    case Sun_event::noon:
+      return ((events.sunset - events.sunrise) / 2) + events.sunrise;
+    case Sun_event::sunset:
+      return events.sunset;
+    default:
+      return events.sunset_civil;
+  }
+}
+
+Color ease_color(const Color& from, const Color& to, const Fixed_point::Progress& progress, Easing::Curve curve)
+{
+  return Color(Easing::ease_channel(from.r, to.r, progress, curve),
+               Easing::ease_channel(from.g, to.g, progress, curve),
+               Easing::ease_channel(from.b, to.b, progress, curve));
+}
+
+/**
+ * @brief biggest change of channel between two colors
+ */
+uint8_t get_max_delta(const Color& from, const Color& to)
+{
+  uint8_t deltas[] = {static_cast<uint8_t>((to.r > from.r) ? to.r - from.r : from.r - to.r),
+                      static_cast<uint8_t>((to.g > from.g) ? to.g - from.g : from.g - to.g),
+                      static_cast<uint8_t>((to.b > from.b) ? to.b - from.b : from.b - to.b)};
+  uint8_t max_delta = 0;
+  for (auto delta : deltas)
+  {
+    if (delta > max_delta)
+    {
+      max_delta = delta;
+    }
+  }
+  return max_delta;
+}
+
+/**
+ * @brief outputs between two keyframes, colors use easing of first keyframe and servo is linear
+ */
+Scene interpolate(const Keyframe& from, const Keyframe& to, uint32_t now)
+{
+  auto progress = Fixed_point::make_progress(now, from.time, to.time);
+  Scene scene;
+  scene.sun = ease_color(from.scene.sun, to.scene.sun, progress, from.sun_easing);
+  scene.sky.east = ease_color(from.scene.sky.east, to.scene.sky.east, progress, from.sky_easing);
+  scene.sky.zenith = ease_color(from.scene.sky.zenith, to.scene.sky.zenith, progress, from.sky_easing);
+  scene.sky.west = ease_color(from.scene.sky.west, to.scene.sky.west, progress, from.sky_easing);
+  scene.servo = Fixed_point::lerp(from.scene.servo, to.scene.servo, progress);
+  return scene;
+}
+} // namespace
+
+bool Timeline::set_color(uint8_t keyframe, Layer layer, const Color& color)
+{
+  if (keyframe >= max_keyframes)
+  {
+    return false;
+  }
+  for (uint8_t i = 0; i < m_override_count; i++)
+  {
+    if (m_overrides[i].keyframe == keyframe && m_overrides[i].layer == layer)
+    {
+      m_overrides[i].color = color;
+      return true;
+    }
+  }
+  if (m_override_count >= max_overrides)
+  {
+    return false;
+  }
+  m_overrides[m_override_count++] = {keyframe, layer, color};
+  return true;
+}
+
+void Timeline::build(const Keyframe_config* configs, uint8_t count, const Ephemeris::Day_events& events)
+{
+  if (count > max_keyframes)
+  {
+    count = max_keyframes;
+  }
+
+  uint8_t interpolated[max_keyframes];
+  uint32_t previous_time = 0;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    Keyframe_config config;
+    memcpy_P(&config, &configs[i], sizeof(config));
+
+    int16_t minutes = get_event_time(config.event, events) + config.offset;
+    if (minutes < 0)
+    {
+      minutes = 0;
+    }
+    else if (minutes >= m_min_in_day)
+    {
+      minutes = m_min_in_day - 1;
+    }
+    uint32_t time = minutes * m_ms_in_min;
+    if (time < previous_time)
+    {
+      time = previous_time;
+    }
+    previous_time = time;
+
+    m_keyframes[i].time = time;
+    m_keyframes[i].scene = config.scene;
+    m_keyframes[i].sun_easing = config.sun_easing;
+    m_keyframes[i].sky_easing = config.sky_easing;
+    interpolated[i] = config.interpolated;
+    apply_overrides(i, interpolated[i]);
+  }
+  m_count = count;
+  m_cursor = 0;
+
+  resolve_interpolated(interpolated);
+}
+
+Scene Timeline::evaluate(uint32_t now)
+{
+  if (m_count == 0)
+  {
+    return Scene{};
+  }
+  // time went back on new day or RTC sync
+  if (now < m_keyframes[m_cursor].time)
+  {
+    m_cursor = 0;
+  }
+  while (m_cursor + 1 < m_count && now >= m_keyframes[m_cursor + 1].time)
+  {
+    m_cursor++;
+  }
+
+  if (now < m_keyframes[0].time || m_cursor + 1 >= m_count)
+  {
+    return m_keyframes[0].scene;
+  }
+  return interpolate(m_keyframes[m_cursor], m_keyframes[m_cursor + 1], now);
+}
+
+uint16_t Timeline::get_servo_position(uint32_t now) const
+{
+  if (m_count == 0)
+  {
+    return 0;
+  }
+  if (now < m_keyframes[0].time || m_cursor + 1 >= m_count)
+  {
+    return m_keyframes[0].scene.servo << servo_fraction_bits;
+  }
+
+  const Keyframe& from = m_keyframes[m_cursor];
+  const Keyframe& to = m_keyframes[m_cursor + 1];
+  auto progress = Fixed_point::make_progress(now, from.time, to.time);
+  uint16_t start = from.scene.servo << servo_fraction_bits;
+  uint16_t delta = (to.scene.servo > from.scene.servo) ? to.scene.servo - from.scene.servo : from.scene.servo - to.scene.servo;
+  uint16_t step = (static_cast<uint32_t>(delta << servo_fraction_bits) * progress.fraction) >> Fixed_point::q15_shift;
+  return (to.scene.servo > from.scene.servo) ? start + step : start - step;
+}
+
+uint32_t Timeline::get_next_change(uint32_t now) const
+{
+  if (m_count == 0)
+  {
+    return now + m_ms_in_day;
+  }
+  if (now < m_keyframes[0].time)
+  {
+    return m_keyframes[0].time;
+  }
+  if (m_cursor + 1 >= m_count)
+  {
+    return m_keyframes[0].time + m_ms_in_day;
+  }
+
+  const Keyframe& from = m_keyframes[m_cursor];
+  const Keyframe& to = m_keyframes[m_cursor + 1];
+  uint8_t sky_delta = get_max_delta(from.scene.sky.east, to.scene.sky.east);
+  uint8_t delta = get_max_delta(from.scene.sky.zenith, to.scene.sky.zenith);
+  sky_delta = (delta > sky_delta) ? delta : sky_delta;
+  delta = get_max_delta(from.scene.sky.west, to.scene.sky.west);
+  sky_delta = (delta > sky_delta) ? delta : sky_delta;
+
+  // steps of fastest channel in segment, eased channels can be faster than linear by curve slope
+  uint16_t steps = get_max_delta(from.scene.sun, to.scene.sun) * Easing::max_slope(from.sun_easing);
+  uint16_t sky_steps = sky_delta * Easing::max_slope(from.sky_easing);
+  uint16_t servo_steps = (to.scene.servo > from.scene.servo) ? to.scene.servo - from.scene.servo : from.scene.servo - to.scene.servo;
+  servo_steps <<= servo_fraction_bits;
+  steps = (sky_steps > steps) ? sky_steps : steps;
+  steps = (servo_steps > steps) ? servo_steps : steps;
+  if (steps == 0)
+  {
+    return to.time;
+  }
+  return now + (to.time - from.time) / steps;
+}
+
+const Keyframe& Timeline::get_keyframe(uint8_t index) const
+{
+  return m_keyframes[index];
+}
+
+uint8_t Timeline::get_count() const
+{
+  return m_count;
+}
+
+int8_t Timeline::get_active_keyframe(uint32_t now) const
+{
+  if (m_count == 0 || now < m_keyframes[0].time || m_cursor + 1 >= m_count)
+  {
+    return -1;
+  }
+  return m_cursor;
+}
+
+void Timeline::apply_overrides(uint8_t index, uint8_t& interpolated)
+{
+  Scene& scene = m_keyframes[index].scene;
+  for (uint8_t i = 0; i < m_override_count; i++)
+  {
+    const Color_override& change = m_overrides[i];
+    if (change.keyframe != index)
+    {
+      continue;
+    }
+    switch (change.layer)
+    {
+      case Layer::sun:
+        scene.sun = change.color;
+        interpolated &= ~interpolate_sun;
+        break;
+      case Layer::east:
+        scene.sky.east = change.color;
+        interpolated &= ~interpolate_sky;
+        break;
+      case Layer::zenith:
+        scene.sky.zenith = change.color;
+        interpolated &= ~interpolate_sky;
+        break;
+      default:
+        scene.sky.west = change.color;
+        interpolated &= ~interpolate_sky;
+        break;
+    }
+  }
+}
+
+void Timeline::resolve_interpolated(const uint8_t* interpolated)
+{
+  for (uint8_t i = 0; i < m_count; i++)
+  {
+    for (uint8_t flag = interpolate_sun; flag <= interpolate_servo; flag <<= 1)
+    {
+      if (!(interpolated[i] & flag))
+      {
+        continue;
+      }
+      int8_t before = i - 1;
+      while (before >= 0 && (interpolated[before] & flag))
+      {
+        before--;
+      }
+      uint8_t after = i + 1;
+      while (after < m_count && (interpolated[after] & flag))
+      {
+        after++;
+      }
+      if (before < 0 || after >= m_count)
+      {
+        continue;
+      }
+
+      Scene scene = interpolate(m_keyframes[before], m_keyframes[after], m_keyframes[i].time);
+      if (flag == interpolate_sun)
+      {
+        m_keyframes[i].scene.sun = scene.sun;
+      }
+      else if (flag == interpolate_sky)
+      {
+        m_keyframes[i].scene.sky = scene.sky;
+      }
+      else
+      {
+        m_keyframes[i].scene.servo = scene.servo;
+      }
+    }
+  }
+}
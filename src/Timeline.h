@@ -0,0 +1,163 @@
+/**
+ * @file Timeline.h
+ * @brief Keyframes of sun, sky and servo anchored to sun events
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "Easing.h"
+#include "Ephemeris.h"
+#include "Sky_renderer.h"
+
+#include <stdint.h>
+
+///< state of all outputs
+struct Scene
+{
+  Color sun; ///< sun color
+  Sky_gradient sky; ///< sky colors
+  uint8_t servo; ///< servo angle
+};
+
+///< sun events to which keyframes are anchored
+enum class Sun_event : uint8_t
+{
+  sunrise_civil,
+  sunrise,
+  noon,
+  sunset,
+  sunset_civil
+};
+
+///< keyframe description in Config, time is calculated every day from sun event
+struct Keyframe_config
+{
+  Sun_event event; ///< anchor
+  int16_t offset; ///< minutes from anchor
+  Scene scene; ///< outputs on keyframe
+  Easing::Curve sun_easing; ///< curve of sun colors to next keyframe
+  Easing::Curve sky_easing; ///< curve of sky colors to next keyframe
+  uint8_t interpolated; ///< Timeline::interpolate_sun | interpolate_sky | interpolate_servo, value taken between neighbours
+};
+
+///< color of scene which can be changed in runtime
+enum class Layer : uint8_t
+{
+  sun,
+  east,
+  zenith,
+  west
+};
+
+///< color set in runtime instead of color from Config
+struct Color_override
+{
+  uint8_t keyframe; ///< keyframe index
+  Layer layer; ///< changed color
+  Color color; ///< new color
+};
+
+///< keyframe with time for actual day
+struct Keyframe
+{
+  uint32_t time; ///< time in ms from 0:00
+  Scene scene; ///< outputs on keyframe
+  Easing::Curve sun_easing; ///< curve of sun colors to next keyframe
+  Easing::Curve sky_easing; ///< curve of sky colors to next keyframe
+};
+
+class Timeline
+{
+public:
+  static const uint8_t interpolate_sun = 1 << 0; ///< sun color from neighbour keyframes
+  static const uint8_t interpolate_sky = 1 << 1; ///< sky colors from neighbour keyframes
+  static const uint8_t interpolate_servo = 1 << 2; ///< servo angle from neighbour keyframes
+  static const uint8_t servo_fraction_bits = 4; ///< fraction bits of servo position between keyframes, 1/16 degree
+  static const uint8_t max_keyframes = 12; ///< keyframes in one day
+  static const uint8_t max_overrides = 8; ///< colors changed in runtime
+
+  /**
+   * @brief change color of keyframe, used from next build(), changed color is not interpolated anymore
+   * @param keyframe: keyframe index
+   * @param layer: sun or one of sky colors
+   * @param color: new color, perceived brightness
+   * @return true color is stored
+   * @return false keyframe index is out of range or there is no space for more colors
+   */
+  bool set_color(uint8_t keyframe, Layer layer, const Color& color);
+
+  /**
+   * @brief calculate keyframes for day, times are sorted and clamped to day
+   * @param configs: keyframes description in flash, sorted by time
+   * @param count: number of keyframes, up to max_keyframes
+   * @param events: sun events of day
+   */
+  void build(const Keyframe_config* configs, uint8_t count, const Ephemeris::Day_events& events);
+
+  /**
+   * @brief calculate outputs, before first and after last keyframe first keyframe is held (night)
+   * @details cursor moves only forward while time grows, so lookup is O(1) for next frame
+   * @param now: time in ms from 0:00
+   * @return Scene outputs
+   */
+  Scene evaluate(uint32_t now);
+
+  /**
+   * @brief calculate servo angle with fraction, for smooth move between whole degrees
+   * @param now: time in ms from 0:00, same as in last evaluate()
+   * @return uint16_t servo angle in 1/16 degree
+   */
+  uint16_t get_servo_position(uint32_t now) const;
+
+  /**
+   * @brief estimate when outputs change next time, call after evaluate()
+   * @details in transition it is time of one step of fastest channel (servo in 1/16 degree), so change can be late by one step
+   * @param now: time in ms from 0:00, same as in last evaluate()
+   * @return uint32_t time in ms from 0:00 of next change, can be after end of day
+   */
+  uint32_t get_next_change(uint32_t now) const;
+
+  /**
+   * @brief get calculated keyframe
+   * @param index: keyframe index
+   * @return const Keyframe& keyframe
+   */
+  const Keyframe& get_keyframe(uint8_t index) const;
+
+  /**
+   * @brief get number of keyframes
+   * @return uint8_t number of keyframes
+   */
+  uint8_t get_count() const;
+
+  /**
+   * @brief get keyframe which starts actual transition, valid after evaluate()
+   * @param now: time in ms from 0:00, same as in last evaluate()
+   * @return int8_t keyframe index; -1 = night, before first or after last keyframe
+   */
+  int8_t get_active_keyframe(uint32_t now) const;
+
+private:
+  /**
+   * @brief fill values marked as interpolated from keyframes before and after them
+   * @param interpolated: flags from config for each keyframe
+   */
+  void resolve_interpolated(const uint8_t* interpolated);
+
+  /**
+   * @brief put colors from set_color() into keyframe
+   * @param index: keyframe index
+   * @param interpolated: flags of keyframe, flag of changed color is cleared
+   */
+  void apply_overrides(uint8_t index, uint8_t& interpolated);
+
+  Keyframe m_keyframes[max_keyframes]; ///< keyframes sorted by time
+  uint8_t m_count = 0; ///< used keyframes
+  uint8_t m_cursor = 0; ///< keyframe before last evaluated time
+  Color_override m_overrides[max_overrides]; ///< colors from set_color()
+  uint8_t m_override_count = 0; ///< used overrides
+};
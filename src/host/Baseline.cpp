@@ -0,0 +1,182 @@
+/**
+ * @file Baseline.cpp
+ * @brief double precision day model of first main.cpp, golden reference for host tools
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Baseline.h"
+
+#include "Config.h"
+
+#include <Arduino.h>
+#include <math.h>
+
+namespace
+{
+///< day part
+enum class Day_part
+{
+  night,
+  sunrise,
+  before_noon,
+  after_noon,
+  sunset
+};
+
+Day_part check_day_part(uint16_t now, const Baseline::Sun_position& position)
+{
+  if (now > position.sunset_civil.time)
+  {
+    return Day_part::night;
+  }
+  else if (now > position.sunset.time)
+  {
+    return Day_part::sunset;
+  }
+  else if (now > position.noon.time)
+  {
+    return Day_part::after_noon;
+  }
+  else if (now > position.sunrise.time)
+  {
+    return Day_part::before_noon;
+  }
+  else if (now > position.sunrise_civil.time)
+  {
+    return Day_part::sunrise;
+  }
+  return Day_part::night;
+}
+
+uint8_t calculate_servo_position(uint16_t now, Day_part actual_day_part, const Baseline::Sun_position& position)
+{
+  if (actual_day_part == Day_part::sunset)
+  {
+    return Config::max_servo_pos;
+  }
+  else if (actual_day_part == Day_part::sunrise || actual_day_part == Day_part::night)
+  {
+    return Config::min_servo_pos;
+  }
+  return map(now, position.sunrise.time, position.sunset.time, Config::min_servo_pos, Config::max_servo_pos);
+}
+
+Color get_sky_horizon_rgb(uint16_t now, bool is_rising, const Baseline::Sun_position& position)
+{
+  Color night;
+  if (is_rising)
+  {
+    return Baseline::map_on_function(now, position.sunrise_civil, position.sunrise, night, Config::blue_sky, is_rising);
+  }
+  return Baseline::map_on_function(now, position.sunset, position.sunset_civil, Config::blue_sky, night, is_rising);
+}
+
+Color get_sun_horizon_rgb(uint16_t now, bool is_rising, const Baseline::Sun_position& position)
+{
+  if (is_rising)
+  {
+    return Baseline::map_on_function(
+        now, position.sunrise_civil, position.sunrise, position.sunrise_civil.color, position.sunrise.color, is_rising);
+  }
+  return Baseline::map_on_function(
+      now, position.sunset, position.sunset_civil, position.sunset.color, position.sunset_civil.color, is_rising);
+}
+
+/**
+ * @brief same as original, blue stays 0 and is_afternoon selects segment from sunrise to noon
+ */
+Color get_sun_day_rgb(uint16_t now, bool is_afternoon, const Baseline::Sun_position& position)
+{
+  Color color;
+  if (is_afternoon)
+  {
+    color.r = map(now, position.sunrise.time, position.noon.time, position.sunrise.color.r, position.noon.color.r);
+    color.g = map(now, position.sunrise.time, position.noon.time, position.sunrise.color.g, position.noon.color.g);
+    return color;
+  }
+  color.r = map(now, position.noon.time, position.sunset.time, position.noon.color.r, position.sunset.color.r);
+  color.g = map(now, position.noon.time, position.sunset.time, position.noon.color.g, position.sunset.color.g);
+  return color;
+}
+} // namespace
+
+uint16_t Baseline::sin_fun(long x, uint8_t max)
+{
+  if (max == 0)
+  {
+    return 0;
+  }
+  return double(max) * (sin((double(x - max) * M_PI) / double(max * 2))) + double(max);
+}
+
+Color Baseline::map_on_function(uint16_t now, Point min_time, Point max_time, Color min_color, Color max_color, bool is_rising)
+{
+  Color retval;
+  Color max_fun_color;
+
+  if (is_rising)
+  {
+    max_fun_color = max_color;
+  }
+  else
+  {
+    max_fun_color = min_color;
+  }
+
+  auto y = map(now, min_time.time, max_time.time, min_color.r, max_color.r);
+  retval.r = sin_fun(y, max_fun_color.r);
+  y = map(now, min_time.time, max_time.time, min_color.g, max_color.g);
+  retval.g = sin_fun(y, max_fun_color.g);
+  y = map(now, min_time.time, max_time.time, min_color.b, max_color.b);
+  retval.b = sin_fun(y, max_fun_color.b);
+
+  return retval;
+}
+
+Baseline::Sun_position Baseline::calculate_sunrise_sunset(SunSet& sun)
+{
+  uint16_t sunrise = static_cast<uint16_t>(sun.calcSunrise());
+  uint16_t sunset = static_cast<uint16_t>(sun.calcSunset());
+  uint16_t sunrise_civil = static_cast<uint16_t>(sun.calcCivilSunrise());
+  uint16_t sunset_civil = static_cast<uint16_t>(sun.calcCivilSunset());
+  uint16_t day_middle = ((sunset - sunrise) / 2) + sunrise;
+
+  Sun_position position;
+  position.sunrise_civil = {sunrise_civil, Color()};
+  position.sunrise = {sunrise, Config::horizon_sun};
+  position.noon = {day_middle, Config::noon};
+  position.sunset = {sunset, Config::horizon_sun};
+  position.sunset_civil = {sunset_civil, Color()};
+  return position;
+}
+
+Baseline::Outputs Baseline::get_outputs(uint16_t now, const Sun_position& position)
+{
+  Day_part actual_day_part = check_day_part(now, position);
+  Outputs outputs;
+  outputs.servo = calculate_servo_position(now, actual_day_part, position);
+  switch (actual_day_part)
+  {
+    case Day_part::sunset:
+      outputs.sun = get_sun_horizon_rgb(now, false, position);
+      outputs.sky = get_sky_horizon_rgb(now, false, position);
+      break;
+    case Day_part::after_noon:
+      outputs.sun = get_sun_day_rgb(now, false, position);
+      outputs.sky = Config::blue_sky;
+      break;
+    case Day_part::before_noon:
+      outputs.sun = get_sun_day_rgb(now, true, position);
+      outputs.sky = Config::blue_sky;
+      break;
+    case Day_part::sunrise:
+      outputs.sun = get_sun_horizon_rgb(now, true, position);
+      outputs.sky = get_sky_horizon_rgb(now, true, position);
+      break;
+    default:
+      break;
+  }
+  return outputs;
+}
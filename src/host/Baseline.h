@@ -0,0 +1,78 @@
+/**
+ * @file Baseline.h
+ * @brief double precision day model of first main.cpp, golden reference for host tools
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Color.h"
+#include "sunset.h"
+
+#include <stdint.h>
+
+namespace Baseline
+{
+///< characteristic point of sun, time and color
+struct Point
+{
+  uint16_t time; ///< time in minutes from 0:00
+  Color color; ///< color
+};
+
+///< characteristic points for the sun on sky
+struct Sun_position
+{
+  Point sunrise_civil;
+  Point sunrise;
+  Point noon;
+  Point sunset;
+  Point sunset_civil;
+};
+
+///< outputs written by original loop()
+struct Outputs
+{
+  Color sun; ///< RGB LED
+  Color sky; ///< whole strip
+  uint8_t servo; ///< servo angle
+};
+
+/**
+ * @brief calculate regarding sin function, color more linear for eye
+ * @details same as original, except max = 0 which gave NaN converted to integer, here it is 0
+ * @param x: value for calculation
+ * @param max: maximum value for the output
+ * @return uint16_t return value from calculation
+ */
+uint16_t sin_fun(long x, uint8_t max);
+
+/**
+ * @brief fit parameters to mathematical function, Arduino map() and sin_fun() for each channel
+ * @param now: time in minutes from 0:00
+ * @param min_time: minimal input time(now)
+ * @param max_time: maximum input time(now)
+ * @param min_color: minimal color saturations to output
+ * @param max_color: maximum color saturations to output
+ * @param is_rising: function direction
+ * @return Color output from mathematical function
+ */
+Color map_on_function(uint16_t now, Point min_time, Point max_time, Color min_color, Color max_color, bool is_rising);
+
+/**
+ * @brief calculate sunrise and sunset times, truncated to minutes, noon in the middle, colors from Config
+ * @param sun: SunSet with position and date
+ * @return Sun_position characteristic points of day
+ */
+Sun_position calculate_sunrise_sunset(SunSet& sun);
+
+/**
+ * @brief outputs of original loop() for minute of day, day part, sun, sky and servo functions are same as original
+ * @param now: time in minutes from 0:00
+ * @param position: characteristic points of day
+ * @return Outputs sun, sky and servo
+ */
+Outputs get_outputs(uint16_t now, const Sun_position& position);
+} // namespace Baseline
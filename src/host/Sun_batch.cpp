@@ -0,0 +1,475 @@
+/**
+ * @file Sun_batch.cpp
+ * @brief host SunSet algorithm for many locations and whole year, vectorized across locations and split across threads
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Sun_batch.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+typedef double Vec __attribute__((vector_size(Sun_batch::lanes * sizeof(double)))); ///< one value of each location in lanes
+typedef uint64_t Bits __attribute__((vector_size(Sun_batch::lanes * sizeof(uint64_t)))); ///< bits of Vec, also result of compare
+
+const double m_pi = 3.14159265358979323846;
+const double m_jd_j2000 = 2451545.0; ///< Julian date of J2000.0
+const double m_days_in_century = 36525.0;
+const double m_min_in_day = 1440.0;
+const uint64_t m_sign_bit = 1ULL << 63;
+
+///< sin and cos series for |x| <= pi/4, x^n / n! with sign, error below 1e-17
+constexpr double m_sin_coefficients[] = {-1.0 / 6,
+                                         1.0 / 120,
+                                         -1.0 / 5040,
+                                         1.0 / 362880,
+                                         -1.0 / 39916800,
+                                         1.0 / 6227020800,
+                                         -1.0 / 1307674368000,
+                                         1.0 / 355687428096000};
+constexpr double m_cos_coefficients[] = {-1.0 / 2,
+                                         1.0 / 24,
+                                         -1.0 / 720,
+                                         1.0 / 40320,
+                                         -1.0 / 3628800,
+                                         1.0 / 479001600,
+                                         -1.0 / 87178291200,
+                                         1.0 / 20922789888000};
+
+Vec from_bits(Bits bits)
+{
+  return (Vec)bits;
+}
+
+Bits to_bits(Vec value)
+{
+  return (Bits)value;
+}
+
+Vec load(const double* values)
+{
+  Vec result;
+  memcpy(&result, values, sizeof(result));
+  return result;
+}
+
+/**
+ * @brief store first lanes of vector, tail of array can be shorter than vector
+ */
+void store(double* values, Vec value, size_t count)
+{
+  memcpy(values, &value, count * sizeof(double));
+}
+
+Vec select(Bits mask, Vec if_true, Vec if_false)
+{
+  return from_bits((mask & to_bits(if_true)) | (~mask & to_bits(if_false)));
+}
+
+template <size_t count>
+Vec polynomial(Vec x, const double (&coefficients)[count])
+{
+  Vec sum = Vec{} + coefficients[count - 1];
+#pragma GCC unroll 20
+  for (size_t i = count - 1; i > 0; i--)
+  {
+    sum = sum * x + coefficients[i - 1];
+  }
+  return sum;
+}
+
+/**
+ * @brief sinus and cosinus with one range reduction
+ * @param x: angle in radians, |x| below 1e6
+ * @param sin_x: sinus
+ * @param cos_x: cosinus
+ */
+void sin_cos_rad(Vec x, Vec& sin_x, Vec& cos_x)
+{
+  // adding 1.5 * 2^52 rounds to integer, which is also in low bits of mantissa
+  const double round_magic = 6755399441055744.0;
+  // pi/2 split in two, high part has 33 bits so k * high is exact (Cody-Waite)
+  const double half_pi_high = 1.57079632673412561417e+00;
+  const double half_pi_low = 6.07710050650619224932e-11;
+
+  Vec shifted = x * (2.0 / m_pi) + round_magic;
+  Vec k = shifted - round_magic;
+  Bits quadrant = to_bits(shifted);
+  Vec r = (x - k * half_pi_high) - k * half_pi_low;
+  Vec r2 = r * r;
+  Vec sin_r = r + r * r2 * polynomial(r2, m_sin_coefficients);
+  Vec cos_r = 1.0 + r2 * polynomial(r2, m_cos_coefficients);
+  // odd quadrant swaps sin and cos, sign comes from quadrant of each result
+  Bits is_even = (Bits)((quadrant & 1) == 0);
+  sin_x = from_bits(to_bits(select(is_even, sin_r, cos_r)) ^ ((quadrant & 2) << 62));
+  cos_x = from_bits(to_bits(select(is_even, cos_r, sin_r)) ^ (((quadrant + 1) & 2) << 62));
+}
+
+Vec sqrt_rad(Vec x)
+{
+  Vec result;
+  for (size_t i = 0; i < Sun_batch::lanes; i++)
+  {
+    result[i] = sqrt(x[i]);
+  }
+  return result;
+}
+
+Vec sin_rad(Vec x)
+{
+  Vec sin_x, cos_x;
+  sin_cos_rad(x, sin_x, cos_x);
+  return sin_x;
+}
+
+Vec tan_rad(Vec x)
+{
+  Vec sin_x, cos_x;
+  sin_cos_rad(x, sin_x, cos_x);
+  return sin_x / cos_x;
+}
+
+/**
+ * @brief arcus tangent, argument reduced to |x| <= tan(pi/8) where 20 terms of series give double precision
+ */
+Vec atan_rad(Vec x)
+{
+  const double tan_3pi_8 = 2.41421356237309504880;
+  const double tan_pi_8 = 0.41421356237309504880;
+  static constexpr double coefficients[] = {1.0,        -1.0 / 3,  1.0 / 5,  -1.0 / 7,  1.0 / 9,  -1.0 / 11, 1.0 / 13,
+                                            -1.0 / 15,  1.0 / 17,  -1.0 / 19, 1.0 / 21, -1.0 / 23, 1.0 / 25, -1.0 / 27,
+                                            1.0 / 29,   -1.0 / 31, 1.0 / 33, -1.0 / 35, 1.0 / 37, -1.0 / 39};
+
+  Bits sign = to_bits(x) & m_sign_bit;
+  Vec abs_x = from_bits(to_bits(x) & ~m_sign_bit);
+  Bits is_big = (Bits)(abs_x > tan_3pi_8);
+  Bits is_middle = (Bits)(abs_x > tan_pi_8);
+  // atan(x) = pi/2 - atan(1/x) = pi/4 + atan((x - 1) / (x + 1)), lanes of other range are computed and dropped
+  Vec reduced = select(is_big, -1.0 / abs_x, select(is_middle, (abs_x - 1.0) / (abs_x + 1.0), abs_x));
+  Vec base = select(is_big, Vec{} + m_pi / 2, select(is_middle, Vec{} + m_pi / 4, Vec{}));
+  Vec result = base + reduced * polynomial(reduced * reduced, coefficients);
+  return from_bits(to_bits(result) ^ sign);
+}
+
+/**
+ * @brief arcus sinus, NaN out of -1..1 as in libm
+ */
+Vec asin_rad(Vec x)
+{
+  return atan_rad(x / sqrt_rad((1.0 - x) * (1.0 + x)));
+}
+
+Vec acos_rad(Vec x)
+{
+  return m_pi / 2 - asin_rad(x);
+}
+
+Vec clamp_unit(Vec x)
+{
+  return select((Bits)(x > 1.0), Vec{} + 1.0, select((Bits)(x < -1.0), Vec{} - 1.0, x));
+}
+
+// scalar versions for values shared by all locations, same names as vector versions for templates below
+void sin_cos_rad(double x, double& sin_x, double& cos_x)
+{
+  sin_x = sin(x);
+  cos_x = cos(x);
+}
+
+double sin_rad(double x)
+{
+  return sin(x);
+}
+
+double tan_rad(double x)
+{
+  return tan(x);
+}
+
+double asin_rad(double x)
+{
+  return asin(x);
+}
+
+// SunSet formulas with the same order of operations, T is double or Vec
+template <typename T>
+T deg_to_rad(T angle)
+{
+  return m_pi * angle / 180.0;
+}
+
+template <typename T>
+T rad_to_deg(T angle)
+{
+  return 180.0 * angle / m_pi;
+}
+
+template <typename T>
+T calc_time_julian_cent(T jd)
+{
+  return (jd - m_jd_j2000) / m_days_in_century;
+}
+
+template <typename T>
+T calc_jd_from_julian_cent(T t)
+{
+  return t * m_days_in_century + m_jd_j2000;
+}
+
+template <typename T>
+T calc_mean_obliquity_of_ecliptic(T t)
+{
+  T seconds = 21.448 - t * (46.8150 + t * (0.00059 - t * (0.001813)));
+  return 23.0 + (26.0 + (seconds / 60.0)) / 60.0;
+}
+
+template <typename T>
+T calc_geom_mean_long_sun(T t)
+{
+  return 280.46646 + t * (36000.76983 + 0.0003032 * t);
+}
+
+template <typename T>
+T calc_eccentricity_earth_orbit(T t)
+{
+  return 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+}
+
+template <typename T>
+T calc_geom_mean_anomaly_sun(T t)
+{
+  return 357.52911 + t * (35999.05029 - 0.0001537 * t);
+}
+
+///< values of calcEquationOfTime and calcSunDeclination for one time
+template <typename T>
+struct Sun_terms
+{
+  T eq_time; ///< equation of time in minutes
+  T declination; ///< declination in degrees
+};
+
+/**
+ * @brief SunSet::calcEquationOfTime and SunSet::calcSunDeclination together, angles used by both are reduced once
+ */
+template <typename T>
+Sun_terms<T> calc_sun_terms(T t)
+{
+  // calcObliquityCorrection and calcSunApparentLong use same omega
+  T omega = 125.04 - 1934.136 * t;
+  T sin_omega, cos_omega;
+  sin_cos_rad(deg_to_rad(omega), sin_omega, cos_omega);
+  T epsilon = calc_mean_obliquity_of_ecliptic(t) + 0.00256 * cos_omega;
+  T l0 = calc_geom_mean_long_sun(t);
+  T e = calc_eccentricity_earth_orbit(t);
+  T mrad = deg_to_rad(calc_geom_mean_anomaly_sun(t));
+  T sinm = sin_rad(mrad);
+  T sin2m = sin_rad(mrad + mrad);
+  T sin3m = sin_rad(mrad + mrad + mrad);
+
+  // calcEquationOfTime
+  T y = tan_rad(deg_to_rad(epsilon) / 2.0);
+  y *= y;
+  T sin2l0, cos2l0;
+  sin_cos_rad(2.0 * deg_to_rad(l0), sin2l0, cos2l0);
+  T sin4l0 = sin_rad(4.0 * deg_to_rad(l0));
+  T e_time = y * sin2l0 - 2.0 * e * sinm + 4.0 * e * y * sinm * cos2l0 - 0.5 * y * y * sin4l0 - 1.25 * e * e * sin2m;
+
+  // calcSunDeclination
+  T c = sinm * (1.914602 - t * (0.004817 + 0.000014 * t)) + sin2m * (0.019993 - 0.000101 * t) + sin3m * 0.000289;
+  T lambda = l0 + c - 0.00569 - 0.00478 * sin_omega;
+  T sint = sin_rad(deg_to_rad(epsilon)) * sin_rad(deg_to_rad(lambda));
+
+  return {rad_to_deg(e_time) * 4.0, rad_to_deg(asin_rad(sint))};
+}
+
+/**
+ * @brief SunSet::calcHourAngleSunrise with cos and tan of latitude calculated once per location
+ */
+Vec calc_hour_angle_sunrise(Vec cos_lat, Vec tan_lat, Vec cos_dec, Vec tan_dec, double cos_zenith, bool is_clamped)
+{
+  Vec cos_ha = cos_zenith / (cos_lat * cos_dec) - tan_lat * tan_dec;
+  return acos_rad(is_clamped ? clamp_unit(cos_ha) : cos_ha);
+}
+
+///< values of first pass, same for all locations
+struct Day_terms
+{
+  double t; ///< Julian centuries of midnight UTC
+  double eq_time; ///< equation of time in minutes
+  double cos_dec; ///< cos of declination
+  double tan_dec; ///< tan of declination
+};
+
+///< inputs of all locations, padded to lanes
+struct Location_terms
+{
+  std::vector<double> cos_lat;
+  std::vector<double> tan_lat;
+  std::vector<double> longitude;
+};
+
+/**
+ * @brief second pass of SunSet::calcAbsSunrise/calcAbsSunset for lanes locations
+ * @param day: first pass values of date
+ * @param cos_lat: cos of latitudes
+ * @param tan_lat: tan of latitudes
+ * @param longitude: longitudes in degrees
+ * @param hour_angle: first pass hour angle of sunrise in radians
+ * @param cos_zenith: cos of sun zenith angle for event
+ * @param is_rising: true = sunrise; false = sunset, hour angle is negative
+ * @param is_clamped: hour angle of polar day and night is clamped
+ * @return Vec time in minutes from 0:00 UTC
+ */
+Vec calc_abs_event(const Day_terms& day,
+                   Vec cos_lat,
+                   Vec tan_lat,
+                   Vec longitude,
+                   Vec hour_angle,
+                   double cos_zenith,
+                   bool is_rising,
+                   bool is_clamped)
+{
+  if (!is_rising)
+  {
+    hour_angle = -hour_angle;
+  }
+  Vec time_utc = 720.0 - 4.0 * (longitude + rad_to_deg(hour_angle)) - day.eq_time;
+  Vec new_t = calc_time_julian_cent(calc_jd_from_julian_cent(day.t) + time_utc / m_min_in_day);
+
+  Sun_terms<Vec> sun = calc_sun_terms(new_t);
+  Vec sin_dec, cos_dec;
+  sin_cos_rad(deg_to_rad(sun.declination), sin_dec, cos_dec);
+  hour_angle = calc_hour_angle_sunrise(cos_lat, tan_lat, cos_dec, sin_dec / cos_dec, cos_zenith, is_clamped);
+  if (!is_rising)
+  {
+    hour_angle = -hour_angle;
+  }
+  return 720.0 - 4.0 * (longitude + rad_to_deg(hour_angle)) - sun.eq_time;
+}
+
+/**
+ * @brief call function for values in vectors, tail is padded by copy
+ */
+template <typename Function>
+void for_each_vector(const double* input, double* result, size_t count, Function function)
+{
+  for (size_t i = 0; i < count; i += Sun_batch::lanes)
+  {
+    size_t lanes = (count - i < Sun_batch::lanes) ? count - i : Sun_batch::lanes;
+    double padded[Sun_batch::lanes] = {};
+    memcpy(padded, input + i, lanes * sizeof(double));
+    store(result + i, function(load(padded)), lanes);
+  }
+}
+} // namespace
+
+Ephemeris::Day_events Sun_batch_events::get_day_events(size_t location, uint16_t day, double tz_offset) const
+{
+  size_t index = day * location_count + location;
+  Ephemeris::Day_events events;
+  events.sunrise_civil = Ephemeris::to_local_minutes(sunrise_civil[index], tz_offset);
+  events.sunrise = Ephemeris::to_local_minutes(sunrise[index], tz_offset);
+  events.sunset = Ephemeris::to_local_minutes(sunset[index], tz_offset);
+  events.sunset_civil = Ephemeris::to_local_minutes(sunset_civil[index], tz_offset);
+  return events;
+}
+
+Sun_batch::Sun_batch(Thread_pool& pool)
+: m_pool(pool)
+{}
+
+void Sun_batch::calc_equation_of_time(const double* t, double* result, size_t count)
+{
+  for_each_vector(t, result, count, [](Vec value) { return calc_sun_terms(value).eq_time; });
+}
+
+void Sun_batch::calc_sun_declination(const double* t, double* result, size_t count)
+{
+  for_each_vector(t, result, count, [](Vec value) { return calc_sun_terms(value).declination; });
+}
+
+void Sun_batch::calculate(int year, const Sun_batch_locations& locations, bool is_clamped, Sun_batch_events& events)
+{
+  const uint8_t month_length[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  const size_t count = locations.latitude.size();
+
+  // first pass of SunSet depends only on date
+  Day_terms days[Ephemeris::days_in_table];
+  uint16_t index = 0;
+  for (uint8_t month = 1; month <= 12; month++)
+  {
+    for (uint8_t day = 1; day <= month_length[month - 1]; day++)
+    {
+      Day_terms& terms = days[index++];
+      terms.t = Ephemeris::calc_days_from_j2000(year, month, day) / m_days_in_century;
+      Sun_terms<double> sun = calc_sun_terms(terms.t);
+      terms.eq_time = sun.eq_time;
+      double dec_rad = deg_to_rad(sun.declination);
+      terms.cos_dec = cos(dec_rad);
+      terms.tan_dec = tan(dec_rad);
+    }
+  }
+
+  Location_terms terms;
+  size_t padded_count = (count + lanes - 1) / lanes * lanes;
+  terms.cos_lat.resize(padded_count, 1.0);
+  terms.tan_lat.resize(padded_count, 0.0);
+  terms.longitude.resize(padded_count, 0.0);
+  for (size_t i = 0; i < count; i++)
+  {
+    double lat_rad = deg_to_rad(locations.latitude[i]);
+    terms.cos_lat[i] = cos(lat_rad);
+    terms.tan_lat[i] = tan(lat_rad);
+    terms.longitude[i] = locations.longitude[i];
+  }
+
+  events.location_count = count;
+  for (auto* values : {&events.sunrise_civil, &events.sunrise, &events.sunset, &events.sunset_civil})
+  {
+    values->assign(Ephemeris::days_in_table * count, 0.0);
+  }
+
+  const double cos_official = cos(deg_to_rad(Ephemeris::official_zenith));
+  const double cos_civil = cos(deg_to_rad(Ephemeris::civil_zenith));
+  size_t block_count = (padded_count + block_size - 1) / block_size;
+  m_pool.run(block_count, [&](size_t block) {
+    size_t first = block * block_size;
+    size_t last = (first + block_size < padded_count) ? first + block_size : padded_count;
+    for (uint16_t day = 0; day < Ephemeris::days_in_table; day++)
+    {
+      const Day_terms& day_terms = days[day];
+      for (size_t i = first; i < last; i += lanes)
+      {
+        Vec cos_lat = load(&terms.cos_lat[i]);
+        Vec tan_lat = load(&terms.tan_lat[i]);
+        Vec longitude = load(&terms.longitude[i]);
+        Vec cos_dec = Vec{} + day_terms.cos_dec;
+        Vec tan_dec = Vec{} + day_terms.tan_dec;
+        size_t offset = day * count + i;
+        size_t stored = (count - i < lanes) ? count - i : lanes;
+
+        // first pass hour angle is same for sunrise and sunset
+        Vec official = calc_hour_angle_sunrise(cos_lat, tan_lat, cos_dec, tan_dec, cos_official, is_clamped);
+        store(&events.sunrise[offset],
+              calc_abs_event(day_terms, cos_lat, tan_lat, longitude, official, cos_official, true, is_clamped),
+              stored);
+        store(&events.sunset[offset],
+              calc_abs_event(day_terms, cos_lat, tan_lat, longitude, official, cos_official, false, is_clamped),
+              stored);
+
+        Vec civil = calc_hour_angle_sunrise(cos_lat, tan_lat, cos_dec, tan_dec, cos_civil, is_clamped);
+        store(&events.sunrise_civil[offset],
+              calc_abs_event(day_terms, cos_lat, tan_lat, longitude, civil, cos_civil, true, is_clamped),
+              stored);
+        store(&events.sunset_civil[offset],
+              calc_abs_event(day_terms, cos_lat, tan_lat, longitude, civil, cos_civil, false, is_clamped),
+              stored);
+      }
+    }
+  });
+}
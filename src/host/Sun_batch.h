@@ -0,0 +1,90 @@
+/**
+ * @file Sun_batch.h
+ * @brief host SunSet algorithm for many locations and whole year, vectorized across locations and split across threads
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include "Ephemeris.h"
+#include "Thread_pool.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+///< locations as structure of arrays
+struct Sun_batch_locations
+{
+  std::vector<double> latitude; ///< degrees, north is positive
+  std::vector<double> longitude; ///< degrees, east is positive
+};
+
+///< events for every location and day of table, value of location i and day d is at [d * location_count + i]
+struct Sun_batch_events
+{
+  size_t location_count = 0;
+  std::vector<double> sunrise_civil; ///< minutes from 0:00 UTC, NaN in polar day or night when not clamped
+  std::vector<double> sunrise;
+  std::vector<double> sunset;
+  std::vector<double> sunset_civil;
+
+  /**
+   * @brief convert events of one location and day to firmware format
+   * @param location: location index
+   * @param day: day index, see Ephemeris::day_of_year()
+   * @param tz_offset: timezone offset in hours
+   * @return Ephemeris::Day_events events in local time, clamped to day as in Ephemeris::make_year_table()
+   * @details events have to be calculated with is_clamped, NaN has no local time
+   */
+  Ephemeris::Day_events get_day_events(size_t location, uint16_t day, double tz_offset) const;
+};
+
+/**
+ * @brief same formulas and passes as SunSet::calcAbsSunrise/calcAbsSunset, results differ only by rounding
+ * @details first pass of SunSet depends only on date, so equation of time and declination are calculated once per day for all
+ * locations. Second pass is calculated for lanes locations at once with GCC vector extensions and own sin/cos/atan polynomials,
+ * blocks of locations are tasks of thread pool.
+ */
+class Sun_batch
+{
+public:
+  static const size_t lanes = 8; ///< locations in one vector, compiler splits it into two AVX registers which hide latency of each other
+  static const size_t block_size = 64; ///< locations in one task of thread pool
+
+  /**
+   * @brief Construct a new Sun_batch
+   * @param pool: threads used by calculate()
+   */
+  explicit Sun_batch(Thread_pool& pool);
+
+  /**
+   * @brief calculate events for every location and every day of table, February always has 29 days
+   * @param year: year of table
+   * @param locations: latitudes and longitudes, same length
+   * @param is_clamped: true = hour angle of polar day and night is clamped as in Ephemeris::make_year_table(), false = NaN as in SunSet
+   * @param events: results, resized for locations
+   */
+  void calculate(int year, const Sun_batch_locations& locations, bool is_clamped, Sun_batch_events& events);
+
+  /**
+   * @brief batch of SunSet::calcEquationOfTime
+   * @param t: Julian centuries from J2000.0
+   * @param result: equation of time in minutes
+   * @param count: number of values
+   */
+  static void calc_equation_of_time(const double* t, double* result, size_t count);
+
+  /**
+   * @brief batch of SunSet::calcSunDeclination
+   * @param t: Julian centuries from J2000.0
+   * @param result: declination in degrees
+   * @param count: number of values
+   */
+  static void calc_sun_declination(const double* t, double* result, size_t count);
+
+private:
+  Thread_pool& m_pool; ///< threads for blocks of locations
+};
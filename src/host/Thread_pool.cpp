@@ -0,0 +1,92 @@
+/**
+ * @file Thread_pool.cpp
+ * @brief host threads started once and reused for batches of independent tasks
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Thread_pool.h"
+
+Thread_pool::Thread_pool(unsigned thread_count)
+{
+  if (thread_count == 0)
+  {
+    thread_count = std::thread::hardware_concurrency();
+  }
+  for (unsigned i = 1; i < thread_count; i++)
+  {
+    m_workers.emplace_back(&Thread_pool::work, this);
+  }
+}
+
+Thread_pool::~Thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_is_stopped = true;
+  }
+  m_batch_started.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+unsigned Thread_pool::get_thread_count() const
+{
+  return m_workers.size() + 1;
+}
+
+void Thread_pool::run(size_t task_count, const std::function<void(size_t)>& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_task_count = task_count;
+    m_next_task = 0;
+    m_busy_workers = m_workers.size();
+    m_batch++;
+  }
+  m_batch_started.notify_all();
+
+  // caller works too, so pool with one thread has no synchronization in tasks
+  run_tasks();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_batch_done.wait(lock, [this] { return m_busy_workers == 0; });
+  m_task = nullptr;
+}
+
+void Thread_pool::work()
+{
+  uint64_t last_batch = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_batch_started.wait(lock, [&] { return m_is_stopped || m_batch != last_batch; });
+      if (m_is_stopped)
+      {
+        return;
+      }
+      last_batch = m_batch;
+    }
+
+    run_tasks();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_busy_workers == 0)
+    {
+      m_batch_done.notify_one();
+    }
+  }
+}
+
+void Thread_pool::run_tasks()
+{
+  for (size_t index = m_next_task++; index < m_task_count; index = m_next_task++)
+  {
+    (*m_task)(index);
+  }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file Thread_pool.h
+ * @brief host threads started once and reused for batches of independent tasks
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+class Thread_pool
+{
+public:
+  /**
+   * @brief start worker threads
+   * @param thread_count: threads working on batch including caller of run(), 0 = one per core
+   */
+  explicit Thread_pool(unsigned thread_count = 0);
+
+  /**
+   * @brief stop and join worker threads
+   */
+  ~Thread_pool();
+
+  Thread_pool(const Thread_pool&) = delete;
+  Thread_pool& operator=(const Thread_pool&) = delete;
+
+  /**
+   * @brief get threads working on batch
+   * @return unsigned workers and caller
+   */
+  unsigned get_thread_count() const;
+
+  /**
+   * @brief run tasks on all threads and wait for end, tasks are taken in order by free threads
+   * @param task_count: number of tasks
+   * @param task: called once for each task index, from many threads at the same time
+   */
+  void run(size_t task_count, const std::function<void(size_t)>& task);
+
+private:
+  /**
+   * @brief worker loop, waits for next batch
+   */
+  void work();
+
+  /**
+   * @brief take and run tasks until batch is empty
+   */
+  void run_tasks();
+
+  std::vector<std::thread> m_workers; ///< threads besides caller of run()
+  std::mutex m_mutex; ///< guards batch fields below
+  std::condition_variable m_batch_started; ///< new batch or stop for workers
+  std::condition_variable m_batch_done; ///< last worker finished batch
+  const std::function<void(size_t)>* m_task = nullptr; ///< task of actual batch
+  size_t m_task_count = 0; ///< tasks in actual batch
+  std::atomic<size_t> m_next_task{0}; ///< next task index to take
+  unsigned m_busy_workers = 0; ///< workers which did not finish actual batch
+  uint64_t m_batch = 0; ///< batch counter, workers wake up when it changes
+  bool m_is_stopped = false; ///< workers exit
+};
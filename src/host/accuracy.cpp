@@ -0,0 +1,475 @@
+/**
+ * @file accuracy.cpp
+ * @brief host comparison of fast integer and constexpr paths with double precision reference and original day model
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Baseline.h"
+#include "Color_correction.h"
+#include "Config.h"
+#include "Easing.h"
+#include "Ephemeris.h"
+#include "RTClib.h"
+#include "Timeline.h"
+#include "sunset.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+const uint16_t m_min_in_day = 1440;
+const uint32_t m_sec_in_day = 86400;
+const uint32_t m_ms_in_min = 60000UL;
+const uint16_t m_max_transition_min = 300; ///< longest transition checked against original functions
+const int m_table_years_before = 4; ///< years before Config::ephemeris_year checked with its table
+const int m_table_years_after = 11; ///< years after Config::ephemeris_year checked with its table
+
+///< error of one output against reference
+struct Error_stats
+{
+  const char* name;
+  const char* unit;
+  double max_bound; ///< allowed maximum of absolute error
+  double rms_bound; ///< allowed RMS error
+  double max = 0;
+  double sum_squares = 0;
+  uint64_t samples = 0;
+
+  void add(double error)
+  {
+    error = fabs(error);
+    if (error > max)
+    {
+      max = error;
+    }
+    sum_squares += error * error;
+    samples++;
+  }
+
+  double get_rms() const
+  {
+    return samples ? sqrt(sum_squares / samples) : 0;
+  }
+
+  bool is_passed() const
+  {
+    return max <= max_bound && get_rms() <= rms_bound;
+  }
+};
+
+enum Error_id
+{
+  sunrise_civil,
+  sunrise,
+  sunset,
+  sunset_civil,
+  events_float,
+  table,
+  table_float,
+  table_years,
+  original_sine,
+  original_linear,
+  curve_smoothstep,
+  curve_exponential,
+  gamma_red,
+  gamma_green,
+  gamma_blue,
+  sun_red,
+  sun_green,
+  sun_blue,
+  sky_red,
+  sky_green,
+  sky_blue,
+  servo,
+  error_count
+};
+
+// max bound = error budget of fast path + margin of one step (minute, lsb or degree), so a flipped rounding after
+// compiler or libm change does not fail the check, but a real regression does; rms bound is rms of error spread evenly
+// over the budget (budget / sqrt(3)), or 0.1 (1% of samples one step off) where budget is 0 or error is only at rare edges.
+// events are compared with truncated reference, same algorithm in double has budget 0;
+// float is precision of avr-gcc double, so of table in flash, budget 1 min (Ephemeris::make_year_table());
+// table of one year used in other years has budget 2 min (make_year_table()), rms 2 / sqrt(3);
+// sine transition against original sin_fun() differs by Q8 input and table of easing, budget 1 lsb, lerp() is same as map()
+// in integers, so map has no margin;
+// curves without original are compared with libm on map() value as original sine, so only Q8 input and table are measured,
+// smoothstep budget 1 lsb as sine, exponential 2 lsb (half lsb of Q8 input times slope 4 near its end), its rms as sine
+// because slope is over 1 only in last part;
+// gamma tables round to nearest, budget 0.5 lsb, margin 0.05 for constexpr pow() against libm, rms 0.5 / sqrt(3) + 0.05 rounded up;
+// sun, sky and servo are whole day of original loop() against Timeline with keyframes of original day, budget 1 lsb of sine,
+// most of day is static so rms is 0.1; servo of original is one map() from sunrise to sunset, Timeline truncates it in noon
+// keyframe and again on both sides, budget 1 degree, rms 1 / sqrt(3)
+Error_stats m_errors[error_count] = {{"sunrise civil", "min", 1.0, 0.1},
+                                     {"sunrise", "min", 1.0, 0.1},
+                                     {"sunset", "min", 1.0, 0.1},
+                                     {"sunset civil", "min", 1.0, 0.1},
+                                     {"float events", "min", 2.0, 0.1},
+                                     {"table events", "min", 1.0, 0.1},
+                                     {"float table", "min", 2.0, 0.1},
+                                     {"table years", "min", 3.0, 1.2},
+                                     {"original sine", "lsb", 2.0, 0.6},
+                                     {"original map", "lsb", 0.0, 0.0},
+                                     {"smoothstep", "lsb", 2.0, 0.6},
+                                     {"exponential", "lsb", 3.0, 0.6},
+                                     {"gamma red", "lsb", 0.55, 0.35},
+                                     {"gamma green", "lsb", 0.55, 0.35},
+                                     {"gamma blue", "lsb", 0.55, 0.35},
+                                     {"sun red", "lsb", 2.0, 0.1},
+                                     {"sun green", "lsb", 2.0, 0.1},
+                                     {"sun blue", "lsb", 2.0, 0.1},
+                                     {"sky red", "lsb", 2.0, 0.1},
+                                     {"sky green", "lsb", 2.0, 0.1},
+                                     {"sky blue", "lsb", 2.0, 0.1},
+                                     {"servo", "deg", 2.0, 0.6}};
+
+// day of first main.cpp as keyframes: sine from civil sunrise, linear sun to noon and back, sine to civil sunset,
+// whole strip has one color, servo is linear from sunrise to sunset, stays at maximum until civil sunset and goes back at night
+// (first keyframe is held after last one)
+constexpr Keyframe_config m_baseline_keyframes[] PROGMEM = {
+    {Sun_event::sunrise_civil,
+     0,
+     {Config::night, {Config::night, Config::night, Config::night}, Config::min_servo_pos},
+     Easing::Curve::sine,
+     Easing::Curve::sine,
+     0},
+    {Sun_event::sunrise,
+     0,
+     {Config::horizon_sun, {Config::blue_sky, Config::blue_sky, Config::blue_sky}, Config::min_servo_pos},
+     Easing::Curve::linear,
+     Easing::Curve::linear,
+     0},
+    {Sun_event::noon,
+     0,
+     {Config::noon, {Config::blue_sky, Config::blue_sky, Config::blue_sky}, 0},
+     Easing::Curve::linear,
+     Easing::Curve::linear,
+     Timeline::interpolate_servo},
+    {Sun_event::sunset,
+     0,
+     {Config::horizon_sun, {Config::blue_sky, Config::blue_sky, Config::blue_sky}, Config::max_servo_pos},
+     Easing::Curve::sine,
+     Easing::Curve::sine,
+     0},
+    {Sun_event::sunset_civil,
+     0,
+     {Config::night, {Config::night, Config::night, Config::night}, Config::max_servo_pos},
+     Easing::Curve::linear,
+     Easing::Curve::linear,
+     0},
+    // original is in sunset part until end of minute of civil sunset, night starts in next one
+    {Sun_event::sunset_civil,
+     1,
+     {Config::night, {Config::night, Config::night, Config::night}, Config::max_servo_pos},
+     Easing::Curve::linear,
+     Easing::Curve::linear,
+     0},
+};
+const uint8_t m_baseline_keyframe_count = sizeof(m_baseline_keyframes) / sizeof(m_baseline_keyframes[0]);
+
+///< grid of locations and year from command line
+struct Settings
+{
+  double lat_step = 30;
+  double lon_step = 90;
+  uint16_t year = Config::ephemeris_year;
+};
+
+/**
+ * @brief curve in double precision with libm instead of tables and constexpr series
+ */
+double reference_curve(Easing::Curve curve, double x)
+{
+  switch (curve)
+  {
+    case Easing::Curve::sine:
+      return 1.0 - cos(x * M_PI / 2.0);
+    case Easing::Curve::smoothstep:
+      return x * x * (3.0 - 2.0 * x);
+    case Easing::Curve::exponential:
+      return (exp(Easing::exponential_rate * x) - 1.0) / (exp(Easing::exponential_rate) - 1.0);
+    default:
+      return x;
+  }
+}
+
+/**
+ * @brief same model as Easing::ease_channel(), curve is applied from darker to brighter value
+ */
+double reference_ease(double from, double to, double progress, Easing::Curve curve)
+{
+  if (curve == Easing::Curve::linear || from == to)
+  {
+    return from + (to - from) * progress;
+  }
+  double dark = (from < to) ? from : to;
+  double x = (from < to) ? progress : 1.0 - progress;
+  return dark + fabs(to - from) * reference_curve(curve, x);
+}
+
+/**
+ * @brief fixed point sine and linear transitions against original double sin_fun() and Arduino map(), every whole minute
+ * @details original sunrise and sunset always go from or to black, channel value is maximum of sin_fun()
+ */
+void check_original_transitions()
+{
+  const Baseline::Point start = {0, Color()};
+  for (uint16_t span = 1; span <= m_max_transition_min; span++)
+  {
+    const Baseline::Point end = {span, Color()};
+    for (uint16_t minute = 0; minute <= span; minute++)
+    {
+      auto progress = Fixed_point::make_progress(minute * m_ms_in_min, 0, span * m_ms_in_min);
+      for (uint16_t value = 1; value <= UINT8_MAX; value++)
+      {
+        Color bright(value, 0, 0);
+        Color rising = Baseline::map_on_function(minute, start, end, Color(), bright, true);
+        Color falling = Baseline::map_on_function(minute, start, end, bright, Color(), false);
+        m_errors[original_sine].add(Easing::ease_channel(0, value, progress, Easing::Curve::sine) - rising.r);
+        m_errors[original_sine].add(Easing::ease_channel(value, 0, progress, Easing::Curve::sine) - falling.r);
+        m_errors[original_linear].add(Easing::ease_channel(0, value, progress, Easing::Curve::linear) - map(minute, 0, span, 0, value));
+        m_errors[original_linear].add(Easing::ease_channel(value, 0, progress, Easing::Curve::linear) - map(minute, 0, span, value, 0));
+      }
+    }
+  }
+}
+
+/**
+ * @brief curves which original did not have against libm, every value and 1/256 of transition
+ * @details reference is applied to truncated linear value and truncated, same structure as original sin_fun(map())
+ */
+void check_curves()
+{
+  const Easing::Curve curves[] = {Easing::Curve::smoothstep, Easing::Curve::exponential};
+  const uint16_t steps = 256;
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    for (uint16_t step = 0; step <= steps; step++)
+    {
+      auto progress = Fixed_point::make_progress(step, 0, steps);
+      for (uint16_t value = 1; value <= UINT8_MAX; value++)
+      {
+        double rising = floor(reference_ease(0, value, static_cast<double>(map(step, 0, steps, 0, value)) / value, curves[i]));
+        double falling = floor(reference_ease(value, 0, 1.0 - static_cast<double>(map(step, 0, steps, value, 0)) / value, curves[i]));
+        m_errors[curve_smoothstep + i].add(Easing::ease_channel(0, value, progress, curves[i]) - rising);
+        m_errors[curve_smoothstep + i].add(Easing::ease_channel(value, 0, progress, curves[i]) - falling);
+      }
+    }
+  }
+}
+
+/**
+ * @brief gamma tables against pow() from libm
+ */
+void check_gamma()
+{
+  const double gammas[] = {Config::gamma_red, Config::gamma_green, Config::gamma_blue};
+  const uint8_t whites[] = {Config::white_balance.r, Config::white_balance.g, Config::white_balance.b};
+  const Colors channels[] = {Colors::red, Colors::green, Colors::blue};
+  for (uint8_t channel = 0; channel < 3; channel++)
+  {
+    for (uint16_t value = 0; value < Color_correction::table_size; value++)
+    {
+      double reference = whites[channel] * pow(value / 255.0, gammas[channel]);
+      m_errors[gamma_red + channel].add(Color_correction::correct(channels[channel], value) - reference);
+    }
+  }
+}
+
+/**
+ * @brief table against SunSet for location from Config, table of one year is used in every year
+ * @param events_table: table made by Ephemeris::make_year_table()
+ * @param year: year of SunSet
+ * @param error: error of all events
+ */
+void check_table(const Ephemeris::Year_table& events_table, uint16_t year, Error_stats& error)
+{
+  SunSet sun(Config::latitude, Config::longitude, static_cast<int>(Config::dst_offset));
+  DateTime date(year, 1, 1);
+  const DateTime end(year + 1, 1, 1);
+  for (; date.unixtime() < end.unixtime(); date = DateTime(date.unixtime() + m_sec_in_day))
+  {
+    sun.setCurrentDate(date.year(), date.month(), date.day());
+    Ephemeris::Day_events events = Ephemeris::get_day_events(events_table, date.month(), date.day());
+    error.add(events.sunrise_civil - floor(sun.calcCivilSunrise()));
+    error.add(events.sunrise - floor(sun.calcSunrise()));
+    error.add(events.sunset - floor(sun.calcSunset()));
+    error.add(events.sunset_civil - floor(sun.calcCivilSunset()));
+  }
+}
+
+/**
+ * @brief tables of compilation against SunSet, float table is calculated as by avr-gcc with 32 bit double
+ */
+void check_tables()
+{
+  static constexpr Ephemeris::Year_table double_table =
+      Ephemeris::make_year_table(Config::ephemeris_year, Config::latitude, Config::longitude, Config::dst_offset);
+  static constexpr Ephemeris::Year_table float_table =
+      Ephemeris::make_year_table<float>(Config::ephemeris_year, Config::latitude, Config::longitude, Config::dst_offset);
+  check_table(double_table, Config::ephemeris_year, m_errors[table]);
+  check_table(float_table, Config::ephemeris_year, m_errors[table_float]);
+  for (int year = Config::ephemeris_year - m_table_years_before; year <= Config::ephemeris_year + m_table_years_after; year++)
+  {
+    check_table(float_table, year, m_errors[table_years]);
+  }
+}
+
+/**
+ * @brief sun events and every minute of outputs for one location
+ * @details original loop() takes its events from SunSet, Timeline from Ephemeris, days when they differ are only counted, because
+ * output jumps by whole transition there and event error has own rows
+ * @param skipped: days skipped because SunSet has no event (polar day or night)
+ * @param other_events: days without output check because some event is in other minute
+ */
+void check_location(uint16_t year, double latitude, double longitude, uint32_t& skipped, uint32_t& other_events)
+{
+  double tz_offset = round(longitude / 15.0);
+  SunSet sun(latitude, longitude, tz_offset);
+  Timeline timeline;
+
+  DateTime date(year, 1, 1);
+  const DateTime end(year + 1, 1, 1);
+  for (; date.unixtime() < end.unixtime(); date = DateTime(date.unixtime() + m_sec_in_day))
+  {
+    sun.setCurrentDate(date.year(), date.month(), date.day());
+    double reference[] = {sun.calcCivilSunrise(), sun.calcSunrise(), sun.calcSunset(), sun.calcCivilSunset()};
+    bool is_valid = true;
+    for (auto time : reference)
+    {
+      is_valid = is_valid && isfinite(time) && time >= 0 && time < m_min_in_day;
+    }
+    if (!is_valid)
+    {
+      skipped++;
+      continue;
+    }
+
+    // SunSet results are truncated same as in calculate_day_events()
+    Ephemeris::Day_events reference_events;
+    reference_events.sunrise_civil = static_cast<uint16_t>(reference[0]);
+    reference_events.sunrise = static_cast<uint16_t>(reference[1]);
+    reference_events.sunset = static_cast<uint16_t>(reference[2]);
+    reference_events.sunset_civil = static_cast<uint16_t>(reference[3]);
+
+    Ephemeris::Day_events events = Ephemeris::calc_day_events(date.year(), date.month(), date.day(), latitude, longitude, tz_offset);
+    m_errors[sunrise_civil].add(events.sunrise_civil - reference_events.sunrise_civil);
+    m_errors[sunrise].add(events.sunrise - reference_events.sunrise);
+    m_errors[sunset].add(events.sunset - reference_events.sunset);
+    m_errors[sunset_civil].add(events.sunset_civil - reference_events.sunset_civil);
+
+    Ephemeris::Day_events float_events =
+        Ephemeris::calc_day_events<float>(date.year(), date.month(), date.day(), latitude, longitude, tz_offset);
+    m_errors[events_float].add(float_events.sunrise_civil - reference_events.sunrise_civil);
+    m_errors[events_float].add(float_events.sunrise - reference_events.sunrise);
+    m_errors[events_float].add(float_events.sunset - reference_events.sunset);
+    m_errors[events_float].add(float_events.sunset_civil - reference_events.sunset_civil);
+
+    if (memcmp(&events, &reference_events, sizeof(events)) != 0)
+    {
+      other_events++;
+      continue;
+    }
+
+    Baseline::Sun_position position = Baseline::calculate_sunrise_sunset(sun);
+    timeline.build(m_baseline_keyframes, m_baseline_keyframe_count, events);
+    for (uint16_t minute = 0; minute < m_min_in_day; minute++)
+    {
+      Scene scene = timeline.evaluate(minute * m_ms_in_min);
+      Baseline::Outputs expected = Baseline::get_outputs(minute, position);
+      m_errors[sun_red].add(scene.sun.r - expected.sun.r);
+      m_errors[sun_green].add(scene.sun.g - expected.sun.g);
+      m_errors[sun_blue].add(scene.sun.b - expected.sun.b);
+      for (const Color* sky : {&scene.sky.east, &scene.sky.zenith, &scene.sky.west})
+      {
+        m_errors[sky_red].add(sky->r - expected.sky.r);
+        m_errors[sky_green].add(sky->g - expected.sky.g);
+        m_errors[sky_blue].add(sky->b - expected.sky.b);
+      }
+      m_errors[servo].add(scene.servo - expected.servo);
+    }
+  }
+}
+
+bool parse_settings(int argc, char** argv, Settings& settings)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--lat-step") == 0 && has_value)
+    {
+      settings.lat_step = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--lon-step") == 0 && has_value)
+    {
+      settings.lon_step = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--year") == 0 && has_value)
+    {
+      settings.year = atoi(argv[++i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: accuracy [--lat-step deg] [--lon-step deg] [--year year]\n");
+      return false;
+    }
+  }
+  return settings.lat_step > 0 && settings.lon_step > 0;
+}
+} // namespace
+
+/**
+ * @brief compare every minute of year on grid of locations, exit code 1 when error is over bound
+ * @details latitudes from -60 to 60, longitudes from -180 to 180, timezone from longitude
+ */
+int main(int argc, char** argv)
+{
+  Settings settings;
+  if (!parse_settings(argc, argv, settings))
+  {
+    return 2;
+  }
+
+  uint16_t locations = 0;
+  uint32_t skipped_days = 0;
+  uint32_t other_event_days = 0;
+  for (double latitude = -60; latitude <= 60; latitude += settings.lat_step)
+  {
+    for (double longitude = -180; longitude < 180; longitude += settings.lon_step)
+    {
+      check_location(settings.year, latitude, longitude, skipped_days, other_event_days);
+      locations++;
+    }
+  }
+  check_tables();
+  check_original_transitions();
+  check_curves();
+  check_gamma();
+
+  printf("locations: %u year: %u skipped polar days: %u days with other event minute: %u\n\n",
+         locations,
+         settings.year,
+         skipped_days,
+         other_event_days);
+  printf("%-14s %5s %10s %10s %10s %10s %12s\n", "output", "unit", "max", "max bound", "rms", "rms bound", "samples");
+  bool is_passed = true;
+  for (const auto& error : m_errors)
+  {
+    printf("%-14s %5s %10.3f %10.3f %10.3f %10.3f %12llu %s\n",
+           error.name,
+           error.unit,
+           error.max,
+           error.max_bound,
+           error.get_rms(),
+           error.rms_bound,
+           static_cast<unsigned long long>(error.samples),
+           error.is_passed() ? "" : "FAIL");
+    is_passed = is_passed && error.is_passed();
+  }
+  printf("\n%s\n", is_passed ? "PASSED" : "FAILED");
+  return is_passed ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file batch_benchmark.cpp
+ * @brief host benchmark of Sun_batch against SunSet called in loop, results are compared too
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Config.h"
+#include "Ephemeris.h"
+#include "Sun_batch.h"
+#include "Thread_pool.h"
+#include "sunset.h"
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+const double m_max_difference_min = 1e-6; ///< allowed difference to SunSet, only rounding of polynomials is expected
+const uint8_t m_month_length[12] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+typedef std::chrono::steady_clock Clock;
+
+///< command line options
+struct Settings
+{
+  size_t locations = 4096;
+  unsigned threads = 0; ///< 0 = one per core
+  int year = 2024;
+};
+
+///< comparison of all events
+struct Difference
+{
+  double max = 0; ///< minutes, values which are not NaN in both
+  uint64_t nan_mismatches = 0; ///< NaN only in one result
+};
+
+double elapsed_ms(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief spread locations over globe, polar circles are included
+ */
+Sun_batch_locations make_locations(size_t count)
+{
+  Sun_batch_locations locations;
+  for (size_t i = 0; i < count; i++)
+  {
+    locations.latitude.push_back(-85.0 + 170.0 * (i + 0.5) / count);
+    // golden angle, neighbour latitudes are far in longitude
+    locations.longitude.push_back(fmod(i * 137.50776405, 360.0) - 180.0);
+  }
+  return locations;
+}
+
+/**
+ * @brief reference, SunSet called for every location and day as on device
+ */
+void calculate_scalar(int year, const Sun_batch_locations& locations, Sun_batch_events& events)
+{
+  size_t count = locations.latitude.size();
+  events.location_count = count;
+  for (auto* values : {&events.sunrise_civil, &events.sunrise, &events.sunset, &events.sunset_civil})
+  {
+    values->assign(Ephemeris::days_in_table * count, 0.0);
+  }
+
+  SunSet sun;
+  for (size_t i = 0; i < count; i++)
+  {
+    sun.setPosition(locations.latitude[i], locations.longitude[i], 0.0);
+    uint16_t day = 0;
+    for (uint8_t month = 1; month <= 12; month++)
+    {
+      for (uint8_t day_of_month = 1; day_of_month <= m_month_length[month - 1]; day_of_month++)
+      {
+        sun.setCurrentDate(year, month, day_of_month);
+        size_t index = day * count + i;
+        events.sunrise_civil[index] = sun.calcCivilSunrise();
+        events.sunrise[index] = sun.calcSunrise();
+        events.sunset[index] = sun.calcSunset();
+        events.sunset_civil[index] = sun.calcCivilSunset();
+        day++;
+      }
+    }
+  }
+}
+
+void compare(const std::vector<double>& values, const std::vector<double>& expected, Difference& difference)
+{
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    if (isnan(values[i]) || isnan(expected[i]))
+    {
+      difference.nan_mismatches += isnan(values[i]) != isnan(expected[i]);
+      continue;
+    }
+    double error = fabs(values[i] - expected[i]);
+    if (error > difference.max)
+    {
+      difference.max = error;
+    }
+  }
+}
+
+/**
+ * @brief compare clamped batch with table from compilation for Config location
+ * @return uint16_t days with any event in other minute
+ */
+uint16_t check_table(Sun_batch& batch)
+{
+  static constexpr Ephemeris::Year_table table =
+      Ephemeris::make_year_table(Config::ephemeris_year, Config::latitude, Config::longitude, Config::dst_offset);
+  Sun_batch_locations location;
+  location.latitude.push_back(Config::latitude);
+  location.longitude.push_back(Config::longitude);
+  Sun_batch_events events;
+  batch.calculate(Config::ephemeris_year, location, true, events);
+
+  uint16_t different_days = 0;
+  for (uint16_t day = 0; day < Ephemeris::days_in_table; day++)
+  {
+    Ephemeris::Day_events batch_events = events.get_day_events(0, day, Config::dst_offset);
+    different_days += memcmp(&batch_events, &table.days[day], sizeof(Ephemeris::Day_events)) != 0;
+  }
+  return different_days;
+}
+
+bool parse_settings(int argc, char** argv, Settings& settings)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--locations") == 0 && has_value)
+    {
+      settings.locations = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && has_value)
+    {
+      settings.threads = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--year") == 0 && has_value)
+    {
+      settings.year = atoi(argv[++i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: batch_benchmark [--locations count] [--threads count] [--year year]\n");
+      return false;
+    }
+  }
+  return settings.locations > 0;
+}
+} // namespace
+
+/**
+ * @brief calculate 4 events for every location and day with SunSet, Sun_batch on one thread and on all threads
+ * @details exit code 1 when batch differs from SunSet more than rounding
+ */
+int main(int argc, char** argv)
+{
+  Settings settings;
+  if (!parse_settings(argc, argv, settings))
+  {
+    return 2;
+  }
+
+  Sun_batch_locations locations = make_locations(settings.locations);
+  double events_count = 4.0 * Ephemeris::days_in_table * settings.locations;
+
+  Sun_batch_events expected;
+  auto start = Clock::now();
+  calculate_scalar(settings.year, locations, expected);
+  double scalar_ms = elapsed_ms(start);
+
+  Thread_pool single_pool(1);
+  Sun_batch single_batch(single_pool);
+  Sun_batch_events single_events;
+  start = Clock::now();
+  single_batch.calculate(settings.year, locations, false, single_events);
+  double single_ms = elapsed_ms(start);
+
+  Thread_pool pool(settings.threads);
+  Sun_batch batch(pool);
+  Sun_batch_events events;
+  start = Clock::now();
+  batch.calculate(settings.year, locations, false, events);
+  double pool_ms = elapsed_ms(start);
+
+  Difference difference;
+  compare(events.sunrise_civil, expected.sunrise_civil, difference);
+  compare(events.sunrise, expected.sunrise, difference);
+  compare(events.sunset, expected.sunset, difference);
+  compare(events.sunset_civil, expected.sunset_civil, difference);
+  compare(single_events.sunrise, events.sunrise, difference);
+  uint16_t different_days = check_table(batch);
+
+  printf("locations: %zu days: %u events: %.0f lanes: %zu threads: %u\n\n",
+         settings.locations,
+         Ephemeris::days_in_table,
+         events_count,
+         Sun_batch::lanes,
+         pool.get_thread_count());
+  printf("%-24s %12s %14s %10s\n", "path", "ms", "Mevents/s", "speedup");
+  printf("%-24s %12.1f %14.2f %10.1f\n", "SunSet loop", scalar_ms, events_count / scalar_ms / 1000, 1.0);
+  printf("%-24s %12.1f %14.2f %10.1f\n", "Sun_batch 1 thread", single_ms, events_count / single_ms / 1000, scalar_ms / single_ms);
+  printf("%-24s %12.1f %14.2f %10.1f\n", "Sun_batch thread pool", pool_ms, events_count / pool_ms / 1000, scalar_ms / pool_ms);
+
+  bool is_passed = difference.max <= m_max_difference_min && difference.nan_mismatches == 0;
+  printf("\nmax difference to SunSet: %.3g min (bound %.3g) NaN mismatches: %llu\n",
+         difference.max,
+         m_max_difference_min,
+         static_cast<unsigned long long>(difference.nan_mismatches));
+  printf("days of Config location different from table of compilation: %u\n", different_days);
+  printf("\n%s\n", is_passed ? "PASSED" : "FAILED");
+  return is_passed ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file benchmark.cpp
+ * @brief host benchmark of loop() and its stages on simulated clock
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Baseline.h"
+#include "Config.h"
+#include "Hal_native.h"
+#include "RTClib.h"
+#include "Sky_bus.h"
+#include "Sun_clock.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+void setup();
+void loop();
+
+namespace
+{
+const uint16_t m_min_in_day = 1440;
+const uint32_t m_sec_in_day = 86400;
+
+///< time spent in one stage
+struct Stage
+{
+  const char* name;
+  uint64_t ns;
+  uint32_t calls;
+};
+
+enum Stage_id
+{
+  ephemeris,
+  timeline,
+  servo,
+  output,
+  stage_count
+};
+
+Stage m_stages[stage_count] = {{"ephemeris", 0, 0}, {"timeline", 0, 0}, {"servo", 0, 0}, {"output", 0, 0}};
+
+enum Color_path_id
+{
+  original_path,
+  fixed_path,
+  color_path_count
+};
+
+///< sun and sky colors of sunrise and sunset transitions calculated as in first main.cpp and with fixed point
+Stage m_color_paths[color_path_count] = {{"double sin_fun", 0, 0}, {"fixed point", 0, 0}};
+
+volatile uint32_t m_sink; ///< keeps results from being optimized out
+Sun_clock<Config::Clock_policy> m_stage_clock; ///< clock for stages measured separately, loop() uses own one
+
+typedef std::chrono::steady_clock Clock;
+
+uint64_t elapsed_ns(Clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+Color ease_color(const Color& from, const Color& to, const Fixed_point::Progress& progress)
+{
+  return Color(Easing::ease_channel(from.r, to.r, progress, Easing::Curve::sine),
+               Easing::ease_channel(from.g, to.g, progress, Easing::Curve::sine),
+               Easing::ease_channel(from.b, to.b, progress, Easing::Curve::sine));
+}
+
+/**
+ * @brief measure sun and sky colors of every minute of sunrise and sunset, with original double functions and fixed point
+ * @param events: sun events of day
+ */
+void bench_color_paths(const Ephemeris::Day_events& events)
+{
+  const Baseline::Point transitions[][2] = {{{events.sunrise_civil, Config::night}, {events.sunrise, Config::horizon_sun}},
+                                            {{events.sunset, Config::horizon_sun}, {events.sunset_civil, Config::night}}};
+  const Color skies[][2] = {{Config::night, Config::blue_sky}, {Config::blue_sky, Config::night}};
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    const Baseline::Point& from = transitions[i][0];
+    const Baseline::Point& to = transitions[i][1];
+    bool is_rising = i == 0;
+    uint32_t colors = 2 * (to.time - from.time + 1);
+
+    auto start = Clock::now();
+    for (uint16_t minute = from.time; minute <= to.time; minute++)
+    {
+      Color sun = Baseline::map_on_function(minute, from, to, from.color, to.color, is_rising);
+      Color sky = Baseline::map_on_function(minute, from, to, skies[i][0], skies[i][1], is_rising);
+      sum += sun.get_color() + sky.get_color();
+    }
+    m_color_paths[original_path].ns += elapsed_ns(start);
+    m_color_paths[original_path].calls += colors;
+
+    start = Clock::now();
+    for (uint16_t minute = from.time; minute <= to.time; minute++)
+    {
+      auto progress = Fixed_point::make_progress(minutes_to_ms(minute), minutes_to_ms(from.time), minutes_to_ms(to.time));
+      Color sun = ease_color(from.color, to.color, progress);
+      Color sky = ease_color(skies[i][0], skies[i][1], progress);
+      sum += sun.get_color() + sky.get_color();
+    }
+    m_color_paths[fixed_path].ns += elapsed_ns(start);
+    m_color_paths[fixed_path].calls += colors;
+  }
+  m_sink = m_sink + sum;
+}
+
+/**
+ * @brief measure each stage separately, every stage runs for whole day at once
+ * @param date: simulated day
+ */
+void bench_day(const DateTime& date)
+{
+  static Scene scenes[m_min_in_day];
+
+  auto start = Clock::now();
+  m_stage_clock.calculate_sunrise_sunset(date);
+  m_stages[ephemeris].ns += elapsed_ns(start);
+  m_stages[ephemeris].calls++;
+
+  start = Clock::now();
+  for (uint16_t minute = 0; minute < m_min_in_day; minute++)
+  {
+    scenes[minute] = m_stage_clock.get_scene(minutes_to_ms(minute));
+  }
+  m_stages[timeline].ns += elapsed_ns(start);
+
+  start = Clock::now();
+  for (uint16_t minute = 0; minute < m_min_in_day; minute++)
+  {
+    m_stage_clock.move_servo(scenes[minute].servo << Timeline::servo_fraction_bits);
+  }
+  m_stages[servo].ns += elapsed_ns(start);
+
+  // outputs are written only when changed since last frame, as in loop()
+  m_stage_clock.render_frame(0, false);
+  start = Clock::now();
+  for (uint16_t minute = 0; minute < m_min_in_day; minute++)
+  {
+    m_stage_clock.set_sun_rgb(scenes[minute].sun);
+    m_stage_clock.set_sky_rgb(scenes[minute].sky);
+    Sky_bus::show();
+  }
+  m_stages[output].ns += elapsed_ns(start);
+
+  for (uint8_t i = timeline; i < stage_count; i++)
+  {
+    m_stages[i].calls += m_min_in_day;
+  }
+  m_sink = m_sink + scenes[m_min_in_day / 2].servo + scenes[m_min_in_day / 2].sun.r;
+
+  bench_color_paths(m_stage_clock.calculate_day_events(date));
+}
+} // namespace
+
+/**
+ * @brief replay simulated clock minute by minute
+ * @details usage: benchmark [days]
+ */
+int main(int argc, char** argv)
+{
+  uint32_t days = (argc > 1) ? atoi(argv[1]) : 366;
+  const DateTime start_date(2024, 1, 1);
+
+  Hal_native::set_serial_echo(false);
+  setup();
+
+  // whole loop(), clock moves by minute (more than log time) so every call does full update
+  Hal_native::set_time(start_date);
+  uint32_t ticks = days * m_min_in_day;
+  uint64_t loop_ns = 0;
+  for (uint32_t tick = 0; tick < ticks; tick++)
+  {
+    Hal_native::advance_us(m_sec_in_day / m_min_in_day * 1000000ULL);
+    auto start = Clock::now();
+    loop();
+    loop_ns += elapsed_ns(start);
+  }
+
+  for (uint32_t day = 0; day < days; day++)
+  {
+    bench_day(DateTime(start_date.unixtime() + day * m_sec_in_day));
+  }
+
+  printf("ticks: %u (%u days, 1 tick per minute)\n", ticks, days);
+  printf("loop(): %.1f ns/tick\n\n", static_cast<double>(loop_ns) / ticks);
+  printf("%-16s %12s %10s %12s\n", "stage", "ns/call", "calls", "ns/tick");
+  uint64_t total_ns = 0;
+  for (const auto& stage : m_stages)
+  {
+    printf("%-16s %12.1f %10u %12.1f\n",
+           stage.name,
+           static_cast<double>(stage.ns) / stage.calls,
+           stage.calls,
+           static_cast<double>(stage.ns) / ticks);
+    total_ns += stage.ns;
+  }
+  printf("%-16s %12s %10s %12.1f\n", "sum", "", "", static_cast<double>(total_ns) / ticks);
+
+  // host FPU makes double cheap, on AVR it is emulated in software and difference is bigger
+  printf("\n%-16s %12s %10s\n", "sunrise color", "ns/color", "colors");
+  for (const auto& path : m_color_paths)
+  {
+    printf("%-16s %12.1f %10u\n", path.name, static_cast<double>(path.ns) / path.calls, path.calls);
+  }
+  printf("fixed point is %.1fx faster\n", static_cast<double>(m_color_paths[original_path].ns) / m_color_paths[fixed_path].ns);
+  return 0;
+}
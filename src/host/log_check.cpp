@@ -0,0 +1,116 @@
+/**
+ * @file log_check.cpp
+ * @brief host check of log output, every stats period has to reach Serial completely
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Hal_native.h"
+#include "RTClib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void setup();
+void loop();
+
+namespace
+{
+const uint32_t m_loop_step_us = 10000; ///< simulated time between loop() calls, same as native_main
+const uint8_t m_max_line = 160; ///< longer lines are cut, only beginning is compared
+
+///< counters of log lines
+struct Log_stats
+{
+  uint32_t periods = 0; ///< "Now:" lines
+  uint32_t missing_memory = 0; ///< periods which ended without "free ram:" line
+  uint32_t dropped_reports = 0; ///< "log dropped:" lines
+  bool has_memory = false; ///< actual period has "free ram:" line
+};
+
+char m_line[m_max_line + 1]; ///< actual line
+uint8_t m_line_length = 0; ///< bytes in m_line
+Log_stats m_stats; ///< result
+
+bool starts_with(const char* text, const char* prefix)
+{
+  return strncmp(text, prefix, strlen(prefix)) == 0;
+}
+
+/**
+ * @brief check one complete line, period starts with "Now:" and its stats follow in next loop passes
+ */
+void on_line(const char* line)
+{
+  if (starts_with(line, "Now:"))
+  {
+    if (m_stats.periods > 0 && !m_stats.has_memory)
+    {
+      m_stats.missing_memory++;
+    }
+    m_stats.periods++;
+    m_stats.has_memory = false;
+  }
+  else if (starts_with(line, "free ram:"))
+  {
+    m_stats.has_memory = true;
+  }
+  else if (starts_with(line, "log dropped:"))
+  {
+    m_stats.dropped_reports++;
+  }
+}
+
+void on_serial(char value)
+{
+  if (value == '\r')
+  {
+    return;
+  }
+  if (value == '\n')
+  {
+    m_line[m_line_length] = '\0';
+    on_line(m_line);
+    m_line_length = 0;
+    return;
+  }
+  if (m_line_length < m_max_line)
+  {
+    m_line[m_line_length++] = value;
+  }
+}
+} // namespace
+
+/**
+ * @brief run clock from 0:00 of given day and check that no log line is dropped and memory stats come in every period
+ * @details usage: log_check [year month day [days]], exit code 1 when check fails, last period is not checked because run ends in it
+ */
+int main(int argc, char** argv)
+{
+  uint16_t year = (argc > 3) ? atoi(argv[1]) : 2024;
+  uint8_t month = (argc > 3) ? atoi(argv[2]) : 6;
+  uint8_t day = (argc > 3) ? atoi(argv[3]) : 21;
+  uint32_t days = (argc > 4) ? atoi(argv[4]) : 1;
+
+  Hal_native::set_serial_echo(false);
+  Hal_native::set_serial_handler(on_serial);
+  setup();
+  Hal_native::set_time(DateTime(year, month, day));
+
+  uint64_t end_us = Hal_native::get_time_us() + static_cast<uint64_t>(days) * 86400 * 1000000;
+  while (Hal_native::get_time_us() < end_us)
+  {
+    loop();
+    Hal_native::advance_us(m_loop_step_us);
+  }
+
+  bool is_passed = m_stats.periods > 1 && m_stats.missing_memory == 0 && m_stats.dropped_reports == 0;
+  printf("periods: %u without free ram line: %u log dropped reports: %u\n",
+         m_stats.periods,
+         m_stats.missing_memory,
+         m_stats.dropped_reports);
+  printf("%s\n", is_passed ? "PASSED" : "FAILED");
+  return is_passed ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file native_main.cpp
+ * @brief host build of clock, runs setup() and loop() on simulated clock
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Hal_native.h"
+#include "RTClib.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void setup();
+void loop();
+
+const uint32_t m_loop_step_us = 10000; ///< simulated time between loop() calls
+
+/**
+ * @brief run clock from 0:00 of given day
+ * @details usage: native_main [year month day [days]]
+ */
+int main(int argc, char** argv)
+{
+  uint16_t year = (argc > 3) ? atoi(argv[1]) : 2024;
+  uint8_t month = (argc > 3) ? atoi(argv[2]) : 6;
+  uint8_t day = (argc > 3) ? atoi(argv[3]) : 21;
+  uint32_t days = (argc > 4) ? atoi(argv[4]) : 1;
+
+  setup();
+  Hal_native::set_time(DateTime(year, month, day));
+
+  // loop() can move clock by itself in power down
+  uint64_t end_us = Hal_native::get_time_us() + static_cast<uint64_t>(days) * 86400 * 1000000;
+  uint32_t loops = 0;
+  while (Hal_native::get_time_us() < end_us)
+  {
+    loop();
+    loops++;
+    Hal_native::advance_us(m_loop_step_us);
+  }
+
+  auto counters = Hal_native::get_counters();
+  printf("loops: %u rtc reads: %u\n", loops, counters.rtc_reads);
+  printf("analog writes: %u servo attaches: %u servo writes: %u strip shows: %u serial bytes: %u serial stalls: %u\n",
+         counters.analog_writes,
+         counters.servo_attaches,
+         counters.servo_writes,
+         counters.strip_shows,
+         counters.serial_bytes,
+         counters.serial_stalls);
+  return 0;
+}
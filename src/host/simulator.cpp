@@ -0,0 +1,220 @@
+/**
+ * @file simulator.cpp
+ * @brief host fast-forward of clock outputs for every minute of one or more years
+ * @author by Szymon Markiewicz
+ * @details http://www.inzynierdomu.pl/
+ * @date 10-2026
+ */
+
+#include "Config.h"
+#include "Ephemeris.h"
+#include "Hal_native.h"
+#include "RTClib.h"
+#include "Sun_clock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace
+{
+const uint16_t m_min_in_day = 1440;
+const uint32_t m_sec_in_day = 86400;
+Sun_clock<Config::Clock_policy> m_sim_clock; ///< timeline of simulated days, outputs are not used
+
+///< one minute in binary output, little endian
+struct __attribute__((packed)) Binary_record
+{
+  uint32_t unix_time; ///< local time as unix time
+  uint8_t sun[3];
+  uint8_t east[3];
+  uint8_t zenith[3];
+  uint8_t west[3];
+  uint8_t servo;
+  int8_t keyframe; ///< active keyframe, -1 = night
+};
+
+///< sweep settings from command line
+struct Settings
+{
+  double latitude = Config::latitude;
+  double longitude = Config::longitude;
+  double tz_offset = Config::dst_offset;
+  uint16_t year = Config::ephemeris_year;
+  uint16_t years = 1;
+  bool is_binary = false;
+};
+
+/**
+ * @brief append unsigned number to buffer, faster than printf for big sweeps
+ */
+char* append_number(char* out, uint32_t value)
+{
+  char digits[10];
+  uint8_t count = 0;
+  do
+  {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  while (count)
+  {
+    *out++ = digits[--count];
+  }
+  return out;
+}
+
+char* append_color(char* out, const Color& color)
+{
+  out = append_number(out, color.r);
+  *out++ = ',';
+  out = append_number(out, color.g);
+  *out++ = ',';
+  out = append_number(out, color.b);
+  *out++ = ',';
+  return out;
+}
+
+/**
+ * @brief write one minute as CSV line
+ */
+void write_csv(const DateTime& date, uint16_t minute, const Scene& scene, int8_t keyframe)
+{
+  char line[96];
+  char* out = line;
+  out = append_number(out, date.year());
+  *out++ = '-';
+  *out++ = '0' + date.month() / 10;
+  *out++ = '0' + date.month() % 10;
+  *out++ = '-';
+  *out++ = '0' + date.day() / 10;
+  *out++ = '0' + date.day() % 10;
+  *out++ = ',';
+  out = append_number(out, minute);
+  *out++ = ',';
+  out = append_color(out, scene.sun);
+  out = append_color(out, scene.sky.east);
+  out = append_color(out, scene.sky.zenith);
+  out = append_color(out, scene.sky.west);
+  out = append_number(out, scene.servo);
+  *out++ = ',';
+  if (keyframe < 0)
+  {
+    *out++ = '-';
+    *out++ = '1';
+  }
+  else
+  {
+    out = append_number(out, keyframe);
+  }
+  *out++ = '\n';
+  fwrite(line, 1, out - line, stdout);
+}
+
+/**
+ * @brief write one minute as binary record
+ */
+void write_binary(const DateTime& date, uint16_t minute, const Scene& scene, int8_t keyframe)
+{
+  Binary_record record;
+  record.unix_time = date.unixtime() + minute * 60UL;
+  const Color* colors[] = {&scene.sun, &scene.sky.east, &scene.sky.zenith, &scene.sky.west};
+  uint8_t* fields[] = {record.sun, record.east, record.zenith, record.west};
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    fields[i][0] = colors[i]->r;
+    fields[i][1] = colors[i]->g;
+    fields[i][2] = colors[i]->b;
+  }
+  record.servo = scene.servo;
+  record.keyframe = keyframe;
+  fwrite(&record, sizeof(record), 1, stdout);
+}
+
+/**
+ * @brief read options, unknown option prints usage
+ */
+bool parse_settings(int argc, char** argv, Settings& settings)
+{
+  for (int i = 1; i < argc; i++)
+  {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--binary") == 0)
+    {
+      settings.is_binary = true;
+    }
+    else if (strcmp(argv[i], "--lat") == 0 && has_value)
+    {
+      settings.latitude = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--lon") == 0 && has_value)
+    {
+      settings.longitude = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--tz") == 0 && has_value)
+    {
+      settings.tz_offset = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--year") == 0 && has_value)
+    {
+      settings.year = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--years") == 0 && has_value)
+    {
+      settings.years = atoi(argv[++i]);
+    }
+    else
+    {
+      fprintf(stderr, "usage: simulator [--lat deg] [--lon deg] [--tz hours] [--year year] [--years count] [--binary]\n");
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+/**
+ * @brief sweep every minute of given years, sun events are calculated for given location
+ * @details CSV on stdout: date,minute,sun r,g,b,east r,g,b,zenith r,g,b,west r,g,b,servo,keyframe;
+ * with --binary stdout gets Binary_record (18 bytes) for every minute
+ */
+int main(int argc, char** argv)
+{
+  Settings settings;
+  if (!parse_settings(argc, argv, settings))
+  {
+    return 1;
+  }
+
+  Hal_native::set_serial_echo(false);
+  static char output_buffer[1 << 16];
+  setvbuf(stdout, output_buffer, _IOFBF, sizeof(output_buffer));
+  if (!settings.is_binary)
+  {
+    printf("date,minute,sun_r,sun_g,sun_b,east_r,east_g,east_b,zenith_r,zenith_g,zenith_b,west_r,west_g,west_b,servo,keyframe\n");
+  }
+
+  DateTime date(settings.year, 1, 1);
+  const DateTime end(settings.year + settings.years, 1, 1);
+  while (date.unixtime() < end.unixtime())
+  {
+    m_sim_clock.set_day_events(
+        Ephemeris::calc_day_events(date.year(), date.month(), date.day(), settings.latitude, settings.longitude, settings.tz_offset));
+    for (uint16_t minute = 0; minute < m_min_in_day; minute++)
+    {
+      uint32_t now = minutes_to_ms(minute);
+      Scene scene = m_sim_clock.get_scene(now);
+      int8_t keyframe = m_sim_clock.get_timeline().get_active_keyframe(now);
+      if (settings.is_binary)
+      {
+        write_binary(date, minute, scene, keyframe);
+      }
+      else
+      {
+        write_csv(date, minute, scene, keyframe);
+      }
+    }
+    date = DateTime(date.unixtime() + m_sec_in_day);
+  }
+  return 0;
+}
@@ -6,359 +6,295 @@
  * @date 05-2022
  */
 
-#include "Adafruit_NeoPixel.h"
-#include "Color.h"
+#include "Clock_group.h"
+#include "Command_parser.h"
 #include "Config.h"
+#include "Dither.h"
+#include "Ephemeris_cache.h"
+#include "Frame_pacer.h"
+#include "Log.h"
+#include "Memory.h"
+#include "Power.h"
+#include "Profiler.h"
 #include "RTClib.h"
-#include "sunset.h"
+#include "Sun_clock.h"
+#include "Timebase.h"
 
 #include <Arduino.h>
-#include <Servo.h>
 #include <Wire.h>
-#include <math.h>
 #include <stdint.h>
 
-///< day part
-enum class Day_part
-{
-  night,
-  sunrise,
-  before_noon,
-  after_noon,
-  sunset
-};
-
-struct Point
-{
-  Point()
-  : time(0)
-  {}
-  Point(uint16_t _time, Color _color)
-  : time(_time)
-  , color(_color)
-  {}
-  uint16_t time; ///< time in minutes from 0:00
-  Color color; ///< color
-};
-
-struct Sun_position
-{
-  Point sunrise_civil;
-  Point sunrise;
-  Point noon;
-  Point sunset;
-  Point sunset_civil;
-};
-
-const uint8_t m_min_in_h = 60; ///< minutes in hour
-
-Sun_position sun_position; ///< characteristic points for the sun on sky
-
 RTC_DS1307 m_rtc; ///< DS1307 RTC
-SunSet sun; ///< Sun position calculation
-Servo m_servo; ///< HW servo
-Adafruit_NeoPixel m_ws_leds(Config::led_ws_count, Config::led_ws, NEO_GRB + NEO_KHZ800); ///< WS2812 leds (sky)
-
-/**
- * @brief calculate minutes form 0:00 to hour and minutes
- * @param total_min: minutes form 0:00
- * @return DateTime calculated time
- */
-DateTime calculate_from_minutes(uint16_t total_min)
-{
-  auto minutes = total_min % m_min_in_h;
-  auto houres = (total_min - minutes) / m_min_in_h;
-  return DateTime(1970, 1, 1, houres, minutes);
-}
-
-/**
- * @brief print time on Serial hh:mm:ss
- * @param time: time to print
- */
-void print_time(DateTime time)
-{
-  Serial.print(time.hour(), DEC);
-  Serial.print(":");
-  Serial.print(time.minute(), DEC);
-  Serial.print(":");
-  Serial.println(time.second(), DEC);
-}
-
-/**
- * @brief calculate sunrise and sunset times
- */
-void calculate_sunrise_sunset()
-{
-  uint16_t sunrise = static_cast<uint16_t>(sun.calcSunrise());
-  uint16_t sunset = static_cast<uint16_t>(sun.calcSunset());
-  uint16_t sunrise_civil = static_cast<uint16_t>(sun.calcCivilSunrise());
-  uint16_t sunset_civil = static_cast<uint16_t>(sun.calcCivilSunset());
-  Serial.print("Sunrise civil: ");
-  print_time(calculate_from_minutes(sunrise_civil));
-  Serial.print("Sunrise: ");
-  print_time(calculate_from_minutes(sunrise));
-  Serial.print("Sunset: ");
-  print_time(calculate_from_minutes(sunset));
-  Serial.print("Sunset civil: ");
-  print_time(calculate_from_minutes(sunset_civil));
-
-  Serial.print("middle: ");
-  uint16_t day_middle = ((sunset - sunrise) / 2) + sunrise;
-  print_time(calculate_from_minutes(day_middle));
-
-  sun_position.sunrise_civil = Point(sunrise_civil, Color());
-  sun_position.sunrise = Point(sunrise, Config::horizon_sun);
-  sun_position.noon = Point(day_middle, Config::noon);
-  sun_position.sunset = Point(sunset, Config::horizon_sun);
-  sun_position.sunset_civil = Point(sunset_civil, Color());
-}
-
+Frame_pacer m_frame_pacer(Config::frame_time_ms, Config::frame_budget_us); ///< animation frames timing
+Frame_pacer m_dither_pacer(Config::dither_frame_time_ms, Config::dither_budget_us); ///< dither frames timing, used with SUN_CLOCK_DITHER
+Command_parser m_command_parser; ///< commands from Serial
+Clock_group<Config::clocks> m_clocks; ///< sun, sky and servo of each city
+
+unsigned long m_next_change_ms = 0; ///< Timebase::get_time_ms() when outputs change next time
+bool m_is_synced = false; ///< time was read from RTC, false forces read in next loop
+uint32_t m_events_days[Clock_group<Config::clocks>::count] = {}; ///< local days from 1970 of calculated sun events, 0 forces calculation
+uint8_t m_selected_clock = 0; ///< clock changed by loc, tz and color commands
+
+const uint8_t m_stats_frames = 0; ///< stats lines printed after log, in this order
+const uint8_t m_stats_dither = 1;
+const uint8_t m_stats_outputs = 2; ///< first of lines of clocks, one for each clock
+const uint8_t m_stats_power = m_stats_outputs + Clock_group<Config::clocks>::count;
+const uint8_t m_stats_memory = m_stats_power + 1;
+const uint8_t m_stats_count = m_stats_memory + 1;
+uint8_t m_stats_line = m_stats_count; ///< next stats line, m_stats_count = all printed
+
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
 /**
- * @brief calculate minutes form 0:00
- * @param time: time to calculate
- * @return uint16_t calculated minutes
+ * @brief RTC RAM address of cached events of clock
+ * @param index: clock index
+ * @return uint8_t address, record of clock which does not fit is not cached
  */
-uint16_t calculate_from_datetime(DateTime time)
+constexpr uint8_t get_cache_address(uint8_t index)
 {
-  return (time.hour() * m_min_in_h) + time.minute();
+  return Config::ephemeris_cache_address + index * sizeof(Ephemeris_cache::Record);
 }
+#endif
 
 /**
- * @brief calculate servo angle depending to time
- * @param now: time in minutes from 0:00
- * @param actual_day_part: what part of day (sun on sky) is now
+ * @brief calculate sun events of clock when its local day changed
+ * @param clock: clock
+ * @param date: local date of clock
  */
-uint8_t calculate_servo_position(uint16_t now, const Day_part actual_day_part)
+template <typename Clock>
+void update_day_events(Clock& clock, const DateTime& date)
 {
-  if (actual_day_part == Day_part::sunset)
+#ifdef SUN_CLOCK_RUNTIME_EPHEMERIS
+  // float calculation is done only once per day, also after reset
+  uint8_t address = get_cache_address(clock.get_index());
+  bool is_cached = address + sizeof(Ephemeris_cache::Record) <= Ephemeris_cache::nvram_size;
+  Ephemeris::Day_events events;
+  if (!is_cached || !Ephemeris_cache::load(m_rtc, address, date, clock.get_location(), events))
   {
-    return Config::max_servo_pos;
-  }
-  else if (actual_day_part == Day_part::sunrise || actual_day_part == Day_part::night)
-  {
-    return Config::min_servo_pos;
+    events = clock.calculate_day_events(date);
+    if (is_cached)
+    {
+      Ephemeris_cache::save(m_rtc, address, date, clock.get_location(), events);
+    }
   }
-  else
+  else if constexpr (Log::is_info)
   {
-    return map(now, sun_position.sunrise.time, sun_position.sunset.time, Config::min_servo_pos, Config::max_servo_pos);
+    Log::out.println(F("Sun events from RTC RAM"));
   }
+  clock.set_day_events(events);
+#else
+  clock.calculate_sunrise_sunset(date);
+#endif
 }
 
 /**
- * @brief move servo to angle depending to time
- * @param now: time in minutes from 0:00
- * @param actual_day_part: what part of day (sun on sky) is now
+ * @brief read time from RTC, recalculate sunrise and sunset of clocks where local day changed
  */
-void move_servo(uint16_t now, const Day_part actual_day_part)
+void sync_time()
 {
-  m_servo.attach(Config::pin_servo);
-  uint8_t servo_position = calculate_servo_position(now, actual_day_part);
-
-  Serial.print("servo pos: ");
-  Serial.println(servo_position);
+  Profiler::Scope rtc_scope(Profiler::Stage::rtc);
+  auto now = m_rtc.now();
+  rtc_scope.end();
+  Timebase::sync(calculate_from_datetime(now) / 1000);
 
-  m_servo.write(servo_position);
-  delay(Config::time_for_servo_move);
-  m_servo.detach();
-}
+  if constexpr (Log::is_info)
+  {
+    Log::out.print(F("RTC: "));
+    print_time(now);
+  }
 
-/**
- * @brief calculate regarding sin sunftion, color more linear for eye
- * @param x: value for calculation
- * @param max: maximum value for the output
- * @return uint16_t return value from calculation
- */
-uint16_t sin_fun(long x, uint8_t max)
-{
-  return double(max) * (sin((double(x - max) * M_PI) / double(max * 2))) + double(max);
+  // clocks in other timezones change day at other hour, only these are calculated
+  m_clocks.for_each([&](auto& clock, int8_t shift_h) {
+    DateTime date = shift_datetime(now, shift_h);
+    uint32_t day = date.unixtime() / 86400UL;
+    if (day != m_events_days[clock.get_index()])
+    {
+      Profiler::Scope ephemeris_scope(Profiler::Stage::ephemeris);
+      update_day_events(clock, date);
+      m_events_days[clock.get_index()] = day;
+    }
+  });
 }
 
 /**
- * @brief fit parameters to mathematical function
- * @param now: time in minutes from 0:00
- * @param min_time: minimal input time(now)
- * @param max_time: maximum input time(now)
- * @param min_color: minimal calor staurations to output
- * @param max_color: maximum calor staurations to output
- * @param is_rising: function direction
- * @return Color output from mathematical function
+ * @brief change location or timezone of selected clock
+ * @param command: location or timezone command
+ * @return true location is changed
+ * @return false clock does not accept location
  */
-Color map_on_function(uint16_t now, Point min_time, Point max_time, Color min_color, Color max_color, bool is_rising)
+bool set_location(const Command& command)
 {
-  Color retval;
-  Color max_fun_color;
-
-  if (is_rising)
-  {
-    max_fun_color = max_color;
-  }
-  else
+  bool is_done = false;
+  m_clocks.for_each([&](auto& clock, int8_t) {
+    if (clock.get_index() != m_selected_clock)
+    {
+      return;
+    }
+    Ephemeris::Location location = clock.get_location();
+    if (command.type == Command_type::location)
+    {
+      location.latitude = command.latitude;
+      location.longitude = command.longitude;
+    }
+    else
+    {
+      location.tz_offset = command.tz_offset;
+    }
+    is_done = clock.set_location(location);
+  });
+  if (is_done)
   {
-    max_fun_color = min_color;
+    // date for sun events is read from RTC again
+    m_events_days[m_selected_clock] = 0;
+    m_is_synced = false;
   }
-
-  auto y = map(now, min_time.time, max_time.time, min_color.r, max_color.r);
-  retval.r = sin_fun(y, max_fun_color.r);
-  y = map(now, min_time.time, max_time.time, min_color.g, max_color.g);
-  retval.g = sin_fun(y, max_fun_color.g);
-  y = map(now, min_time.time, max_time.time, min_color.b, max_color.b);
-  retval.b = sin_fun(y, max_fun_color.b);
-
-  return retval;
+  return is_done;
 }
 
 /**
- * @brief Get the sky horizon rgb
- * @param now: time in minutes from 0:00
- * @param is_rising: true = before sunrise; false = after sunset
- * @return Color sky color
+ * @brief change keyframe color of selected clock
+ * @param command: color command
+ * @return true color is changed
+ * @return false wrong keyframe or no space for color
  */
-Color get_sky_horizon_rgb(uint16_t now, bool is_rising)
+bool set_keyframe_color(const Command& command)
 {
-  Color night;
-  if (is_rising)
-  {
-    return map_on_function(now, sun_position.sunrise_civil, sun_position.sunrise, night, Config::blue_sky, is_rising);
-  }
-  return map_on_function(now, sun_position.sunset, sun_position.sunset_civil, Config::blue_sky, night, is_rising);
+  bool is_done = false;
+  m_clocks.for_each([&](auto& clock, int8_t) {
+    if (clock.get_index() == m_selected_clock)
+    {
+      is_done = clock.set_keyframe_color(command.keyframe, command.layer, command.color);
+    }
+  });
+  return is_done;
 }
 
 /**
- * @brief Set the sky rgb
- * @param now: time in minutes from 0:00
- * @param actual_day_part: what part of day (sun on sky) is now
+ * @brief run command from Serial, only values which depend on changed setting are calculated again
+ * @param command: parsed command
  */
-void set_sky_rgb(uint16_t now, const Day_part actual_day_part)
+void execute(const Command& command)
 {
-  Color color;
-
-  switch (actual_day_part)
+  bool is_done = true;
+  switch (command.type)
   {
-    case Day_part::sunset:
-      color = get_sky_horizon_rgb(now, false);
+    case Command_type::none:
+      return;
+    case Command_type::time:
+      // sun events are calculated again only when date changed
+      m_rtc.adjust(command.time);
+      m_is_synced = false;
+      break;
+    case Command_type::location:
+#ifndef SUN_CLOCK_RUNTIME_EPHEMERIS
+      // table of sun events is calculated during compilation for location from Config.h
+      if constexpr (Log::is_error)
+      {
+        Log::out.println(F("location fixed at build"));
+      }
+      return;
+#endif
+    case Command_type::timezone:
+      is_done = set_location(command);
       break;
-    case Day_part::sunrise:
-      color = get_sky_horizon_rgb(now, true);
+    case Command_type::color:
+      // keyframes are rebuilt from sun events of actual day
+      is_done = set_keyframe_color(command);
+      m_next_change_ms = Timebase::get_time_ms();
       break;
-    case Day_part::before_noon:
-      [[fallthrough]];
-    case Day_part::after_noon:
-      color = Config::blue_sky;
+    case Command_type::clock:
+      is_done = command.clock < m_clocks.count;
+      if (is_done)
+      {
+        m_selected_clock = command.clock;
+      }
+      break;
+    case Command_type::profile:
+      if constexpr (Profiler::is_enabled)
+      {
+        Profiler::request_print();
+      }
+      is_done = Profiler::is_enabled;
       break;
     default:
+      is_done = false;
       break;
   }
-
-
-  Serial.println("sky color");
-  color.print_color();
-
-  m_ws_leds.fill(color.get_color());
-  m_ws_leds.show();
-}
-
-/**
- * @brief Get the sun horizon rgb
- * @param now: time in minutes from 0:00
- * @param is_rising: true = before sunrise; false = after sunset
- * @return Color sun color on specify position
- */
-Color get_sun_horizon_rgb(uint16_t now, bool is_rising)
-{
-  // Color color;
-  if (is_rising)
+  if (is_done)
   {
-    return map_on_function(
-        now, sun_position.sunrise_civil, sun_position.sunrise, sun_position.sunrise_civil.color, sun_position.sunrise.color, is_rising);
+    if constexpr (Log::is_info)
+    {
+      Log::out.println(F("ok"));
+    }
   }
-  return map_on_function(
-      now, sun_position.sunset, sun_position.sunset_civil, sun_position.sunset.color, sun_position.sunset_civil.color, is_rising);
-}
-
-/**
- * @brief Get the sun day rgb
- * @param now: time in minutes from 0:00
- * @param is_afternoon: true = afternoon; false = before noon
- * @return Color sun color on specify position
- */
-Color get_sun_day_rgb(uint16_t now, bool is_afternoon)
-{
-  Color color;
-  if (is_afternoon)
+  else if constexpr (Log::is_error)
   {
-    color.r = map(now, sun_position.sunrise.time, sun_position.noon.time, sun_position.sunrise.color.r, sun_position.noon.color.r);
-    color.g = map(now, sun_position.sunrise.time, sun_position.noon.time, sun_position.sunrise.color.g, sun_position.noon.color.g);
-    return color;
+    Log::out.println(F("command error"));
   }
-  color.r = map(now, sun_position.noon.time, sun_position.sunset.time, sun_position.noon.color.r, sun_position.sunset.color.r);
-  color.g = map(now, sun_position.noon.time, sun_position.sunset.time, sun_position.noon.color.g, sun_position.sunset.color.g);
-  return color;
 }
 
 /**
- * @brief check current day part
- * @param now: time in minutes from 0:00
+ * @brief print pending stats lines while log buffer has space for them, rest waits for next loop pass
+ * @details whole period does not fit into log buffer at 9600 baud, stats of line are cleared when line is printed
  */
-Day_part check_day_part(uint16_t now)
+void print_stats()
 {
-  if (now > sun_position.sunset_civil.time)
-  {
-    return Day_part::night;
-  }
-  else if (now > sun_position.sunset.time)
+  while (m_stats_line < m_stats_count && Log::out.has_space(Log::line_size))
   {
-    return Day_part::sunset;
-  }
-  else if (now > sun_position.noon.time)
-  {
-    return Day_part::after_noon;
-  }
-  else if (now > sun_position.sunrise.time)
-  {
-    return Day_part::before_noon;
-  }
-  else if (now > sun_position.sunrise_civil.time)
-  {
-    return Day_part::sunrise;
-  }
-  else
-  {
-    return Day_part::night;
+    uint8_t line = m_stats_line++;
+    if (line == m_stats_frames)
+    {
+      m_frame_pacer.print_stats();
+      m_frame_pacer.reset_stats();
+    }
+    else if (line == m_stats_dither)
+    {
+      if constexpr (Dither::is_enabled)
+      {
+        Log::out.print(F("dither "));
+        m_dither_pacer.print_stats();
+      }
+      m_dither_pacer.reset_stats();
+    }
+    else if (line < m_stats_power)
+    {
+      m_clocks.print_output_stats(line - m_stats_outputs);
+      m_clocks.reset_output_stats(line - m_stats_outputs);
+    }
+    else if (line == m_stats_power)
+    {
+      Power::print_stats();
+      Power::reset_stats();
+    }
+    else
+    {
+      Memory::print_stats();
+    }
   }
 }
 
 /**
- * @brief Set the sun rgb object
- * @param now: time in minutes from 0:00
- * @param actual_day_part: what part of day (sun on sky) is now
+ * @brief sleep until outputs change or next log, power down only when outputs work without timers and SQW counts time
+ * @param now_ms: actual Timebase::get_time_ms()
+ * @param last_log_ms: Timebase::get_time_ms() on last log
  */
-void set_sun_rgb(uint16_t now, const Day_part actual_day_part)
+void sleep_until_next_work(unsigned long now_ms, unsigned long last_log_ms)
 {
-  Color color;
-
-  switch (actual_day_part)
+  uint32_t sleep_ms = Config::m_refresh_time_ms + 1 - (now_ms - last_log_ms);
+  int32_t time_to_change = static_cast<int32_t>(m_next_change_ms - now_ms);
+  if (time_to_change < static_cast<int32_t>(sleep_ms))
   {
-    case Day_part::sunset:
-      color = get_sun_horizon_rgb(now, false);
-      break;
-    case Day_part::after_noon:
-      color = get_sun_day_rgb(now, false);
-      break;
-    case Day_part::before_noon:
-      color = get_sun_day_rgb(now, true);
-      break;
-    case Day_part::sunrise:
-      color = get_sun_horizon_rgb(now, true);
-      break;
-    default:
-      break;
+    sleep_ms = (time_to_change > 0) ? time_to_change : 0;
   }
 
-  Serial.println("sun color");
-  color.print_color();
-  analogWrite(Config::pin_led_r, color.r);
-  analogWrite(Config::pin_led_g, color.g);
-  analogWrite(Config::pin_led_b, color.b);
+  // UART does not receive in power down, RX edge only wakes MCU
+  bool is_command_active = millis() - m_command_parser.get_last_input_ms() < Config::command_awake_ms;
+  if (sleep_ms < Power::min_power_down_ms || !m_clocks.is_output_static() || !Log::out.is_sent() || !Timebase::is_sqw_running() ||
+      is_command_active || Profiler::is_enabled)
+  {
+    Power::idle();
+    return;
+  }
+  Power::power_down(sleep_ms);
 }
 
 /**
@@ -370,20 +306,21 @@ void setup()
 
   if (!m_rtc.begin())
   {
-    Serial.println("Couldn't find RTC");
+    if constexpr (Log::is_error)
+    {
+      Log::out.println(F("Couldn't find RTC"));
+    }
   }
 
-  m_rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
-
-  sun.setPosition(Config::latitude, Config::longitude, Config::dst_offset);
-  auto now = m_rtc.now();
-  sun.setCurrentDate(now.year(), now.month(), now.day());
-
-  pinMode(Config::pin_led_r, OUTPUT);
-  pinMode(Config::pin_led_g, OUTPUT);
-  pinMode(Config::pin_led_b, OUTPUT);
+  // time of compilation only for new RTC, later time is set with command
+  if (!m_rtc.isrunning())
+  {
+    m_rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
+  }
+  m_rtc.writeSqwPinMode(DS1307_SquareWave1HZ);
+  Timebase::begin(Config::pin_rtc_sqw);
 
-  m_ws_leds.begin();
+  m_clocks.init_outputs();
 }
 
 /**
@@ -391,31 +328,77 @@ void setup()
  */
 void loop()
 {
-  static unsigned long last_loop_time = 0;
-  unsigned long loop_time = millis();
-  if (loop_time - last_loop_time > Config::m_refresh_time_ms)
+  Profiler::Scope loop_scope(Profiler::Stage::loop);
+  if constexpr (Profiler::is_enabled)
   {
-    auto now = m_rtc.now();
-
-    Serial.print("Now: ");
-    print_time(now);
-    last_loop_time = millis();
-
-    auto minutes = calculate_from_datetime(now);
+    Profiler::update();
+  }
+  execute(m_command_parser.update());
+  Log::out.flush();
+  m_clocks.update_servo();
+
+  static unsigned long last_log_time = 0;
+  static bool is_started = false;
+  bool is_logged = false;
+  if (!m_is_synced || Timebase::is_sync_due(Config::rtc_sync_time_s))
+  {
+    sync_time();
+    m_next_change_ms = Timebase::get_time_ms();
+    is_logged = !is_started;
+    is_started = true;
+    m_is_synced = true;
+  }
 
-    static bool is_calculated = false;
-    if (minutes == 1 || !is_calculated)
+  unsigned long loop_time = Timebase::get_time_ms();
+  if (is_logged || loop_time - last_log_time > Config::m_refresh_time_ms)
+  {
+    last_log_time = loop_time;
+    is_logged = true;
+    if constexpr (Log::is_info)
     {
-      calculate_sunrise_sunset();
-      is_calculated = true;
+      Log::out.print(F("Now: "));
+      print_time(DateTime(Timebase::get_time_of_day() / 1000));
     }
+  }
 
-    Day_part actual_day_part = check_day_part(minutes);
-
-    move_servo(minutes, actual_day_part);
-
-    set_sun_rgb(minutes, actual_day_part);
+  bool is_change_due = static_cast<int32_t>(loop_time - m_next_change_ms) >= 0;
+  if ((is_change_due && m_frame_pacer.is_frame_due(loop_time)) || is_logged)
+  {
+    m_frame_pacer.begin_frame();
+    uint32_t now = Timebase::get_time_of_day();
+    m_next_change_ms = loop_time + m_clocks.render_frame(now, is_logged);
+    m_frame_pacer.end_frame();
+  }
+  else if (Dither::is_enabled && m_clocks.is_dithering() && m_dither_pacer.is_frame_due(loop_time))
+  {
+    // only outputs are refreshed, next animation frame is not moved
+    m_dither_pacer.begin_frame();
+    m_clocks.refresh_dither();
+    m_dither_pacer.end_frame();
+  }
 
-    set_sky_rgb(minutes, actual_day_part);
+  if (is_logged)
+  {
+    if constexpr (Log::is_info)
+    {
+      m_stats_line = 0;
+    }
+    else
+    {
+      m_frame_pacer.reset_stats();
+      m_dither_pacer.reset_stats();
+      Power::reset_stats();
+    }
+  }
+  if constexpr (Log::is_info)
+  {
+    print_stats();
   }
-}
\ No newline at end of file
+  if constexpr (Log::is_error)
+  {
+    Log::out.report_dropped();
+  }
+
+  loop_scope.end();
+  sleep_until_next_work(loop_time, last_log_time);
+}